@@ -0,0 +1,209 @@
+/**************************************************************************
+ *
+ *  Class Name: async_logger.h
+ *  Purpose:    Verbose output for osproj4.cpp that threads hand off
+ *              instead of printing themselves, so tracing every action
+ *              doesn't line every thread up behind stdout
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _ASYNC_LOGGER_H_DEFINED_
+#define _ASYNC_LOGGER_H_DEFINED_
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include "spsc_buffer.h"
+#include "thread_stats.h"
+
+#define LOG_RING_SIZE (4096)                // events each thread can have waiting for the writer
+#define LOG_DRAIN_BATCH (256)               // most events the writer takes from one ring at a time
+#define LOG_IDLE_NS (1000000L)              // how long the writer sleeps when every ring is empty
+
+enum LogOp : uint8_t {
+    LOG_INSERT,                             // a producer put value in the buffer
+    LOG_REMOVE,                             // a consumer took value out of the buffer
+    LOG_FULL,                               // a producer found the buffer full
+    LOG_EMPTY                               // a consumer found the buffer empty
+};
+
+// one thing a thread did, as it is handed to the writer
+struct LogEvent {
+    long long timestamp;                    // nowNanoseconds() when it happened
+    buffer_item value;                      // the item moved (inserts and removes)
+    int32_t thread;                         // the thread's REF_ID
+    int32_t head;                           // where the buffer's head was right after
+    int32_t tail;                           // where the buffer's tail was right after
+    int32_t size;                           // how many items the buffer held right after
+    LogOp op;
+    bool prime;                             // if a removed value was prime
+};
+
+template<>
+struct NullItem<LogEvent> {
+    static LogEvent value() { return LogEvent{}; }
+};
+
+/***************************************************************
+ *
+ * @brief a logger where threads only ever write to their own ring
+ *
+ * Each thread records events into its own SPSC ring, which costs
+ * a few stores and never takes a lock. One writer thread empties
+ * every ring, puts the events in time order, formats them and
+ * writes each pass to the output with a single fwrite.
+ *
+ * If a thread gets a whole ring ahead of the writer, its newest
+ * events are dropped (and counted) rather than making it wait.
+ *
+ *****************************************************************/
+class AsyncLogger {
+
+    struct ThreadLog {
+        SPSCBuffer<LogEvent, LOG_RING_SIZE> ring;           // events waiting for the writer
+        StatCounter dropped;                                // events lost to a full ring
+    };
+
+    // CLASS DATA MEMBERS //
+    std::vector<std::unique_ptr<ThreadLog>> logs;           // one per thread, indexed by REF_ID
+    FILE *output;                                           // where the formatted lines go
+    long long startTime;                                    // timestamps are printed relative to this
+    std::atomic<bool> stopping{false};                      // set by stop(), the writer drains and exits
+    pthread_t writer{};
+
+    /*****************************************
+     * format()
+     *
+     * @brief appends one event as a line of text
+     *****************************************/
+    void format( const LogEvent &EVENT, std::string &text ) const {
+        char line[160];
+        const double SECONDS = (double)(EVENT.timestamp - startTime) / 1e9;
+        const bool PRODUCER = EVENT.op == LOG_INSERT || EVENT.op == LOG_FULL;
+        int length = snprintf(line, sizeof(line), "[%12.6f] %s %3d ", SECONDS, PRODUCER ? "Producer" : "Consumer", EVENT.thread);
+
+        switch (EVENT.op) {
+            case LOG_FULL:
+                length += snprintf(line + length, sizeof(line) - length, "waits, all buffers full\n");
+                break;
+            case LOG_EMPTY:
+                length += snprintf(line + length, sizeof(line) - length, "waits, all buffers empty\n");
+                break;
+            default:
+                length += snprintf(line + length, sizeof(line) - length, "%s " BUFFER_ITEM_FORMAT "%s\t(buffers occupied: %d  R %d  W %d)\n",
+                                   EVENT.op == LOG_INSERT ? "writes" : "reads ", EVENT.value,
+                                   EVENT.prime ? " *****PRIME NUMBER*****" : "", EVENT.size, EVENT.head, EVENT.tail);
+        } //end switch
+        text.append(line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+    }
+
+    /*****************************************
+     * drain()
+     *
+     * @brief writes out everything the threads have recorded so far
+     *
+     * @return the number of events written
+     *****************************************/
+    size_t drain( std::vector<LogEvent> &events, std::string &text ) {
+        events.clear();
+        LogEvent batch[LOG_DRAIN_BATCH];
+        for (const std::unique_ptr<ThreadLog> &LOG : logs) {
+            size_t taken;
+            while ((taken = LOG->ring.buffer_remove_items(batch, LOG_DRAIN_BATCH)) > 0)
+                events.insert(events.end(), batch, batch + taken);
+        } //end for
+        if (events.empty())
+            return 0;
+
+        std::stable_sort(events.begin(), events.end(), []( const LogEvent &A, const LogEvent &B ) {
+            return A.timestamp < B.timestamp;
+        });
+        text.clear();
+        for (const LogEvent &EVENT : events)
+            format(EVENT, text);
+        fwrite(text.data(), 1, text.size(), output);
+        fflush(output);
+        return events.size();
+    }
+
+    static void* writerMain( void *param ) {
+        AsyncLogger *logger = static_cast<AsyncLogger *>(param);
+        std::vector<LogEvent> events;
+        std::string text;
+        while (!logger->stopping.load(std::memory_order_acquire)) {
+            if (logger->drain(events, text) == 0) {
+                timespec idle{0, LOG_IDLE_NS};
+                nanosleep(&idle, nullptr);
+            } //end if
+        } //end while
+        while (logger->drain(events, text) > 0) {
+            //write whatever was recorded before the threads stopped
+        } //end while
+        return nullptr;
+    }
+
+    public:
+    /*****************************************
+     * AsyncLogger Constructor
+     *
+     * @param THREADS how many threads will record events (REF_IDs 0 up to this)
+     * @param OUTPUT  where to write the lines
+     *
+     ********************************************/
+    explicit AsyncLogger( const int THREADS, FILE *OUTPUT = stdout ) : output(OUTPUT), startTime(nowNanoseconds()) {
+        for (int i = 0; i < THREADS; i++) {
+            logs.emplace_back(new ThreadLog());
+            logs.back()->ring.setWaitStrategy(STRATEGY_SPIN); // the writer polls, so skip the ring's notifies
+        } //end for
+    }
+
+    void start() { pthread_create(&writer, nullptr, writerMain, this); }
+
+    // writes out whatever is left and ends the writer, once every recording thread has stopped
+    void stop() {
+        stopping.store(true, std::memory_order_release);
+        pthread_join(writer, nullptr);
+    }
+
+    /*****************************************
+     * log()
+     *
+     * @brief records one event from the calling thread
+     *
+     * only ever called by the thread THREAD, never blocks
+     *
+     * @param THREAD the caller's REF_ID
+     * @param OP     what happened
+     * @param VALUE  the item moved, if any
+     * @param PRIME  if a removed item was prime
+     * @param BUFFER the buffer, to snapshot head, tail and size from
+     *****************************************/
+    template<typename T>
+    void log( const int THREAD, const LogOp OP, const buffer_item VALUE, const bool PRIME, const BufferBase<T> *BUFFER ) {
+        const LogEvent EVENT = {nowNanoseconds(), VALUE, THREAD, BUFFER->getHead(), BUFFER->getTail(), BUFFER->getSize(), OP, PRIME};
+        ThreadLog &threadLog = *logs[THREAD];
+        if (!threadLog.ring.try_insert(EVENT))
+            threadLog.dropped.add(1);
+    }
+
+    // events lost because a thread's ring was full
+    long long dropped() const {
+        long long total = 0;
+        for (const std::unique_ptr<ThreadLog> &LOG : logs)
+            total += LOG->dropped.get();
+        return total;
+    }
+};
+
+#endif // _ASYNC_LOGGER_H_DEFINED_
@@ -0,0 +1,151 @@
+/**************************************************************************
+ *
+ *  Class Name: autoscaler.h
+ *  Purpose:    Decides how many of osproj4.cpp's consumers should be
+ *              working from how full the buffer is, and parks the rest
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _AUTOSCALER_H_DEFINED_
+#define _AUTOSCALER_H_DEFINED_
+#include <atomic>
+#include <climits>
+#include "eventcount.h"
+
+#define SCALE_UP_OCCUPANCY (0.75)           // a buffer at least this full needs more consumers
+#define SCALE_DOWN_OCCUPANCY (0.25)         // a buffer at most this full (and never full) could use fewer
+#define SCALE_UP_SAMPLES (2)                // samples in a row that have to call for more consumers
+#define SCALE_DOWN_SAMPLES (5)              // samples in a row that have to call for fewer consumers
+#define SCALE_INTERVAL_MS (100)             // default time between samples
+
+/***************************************************************
+ *
+ * @brief an elastic pool of consumers
+ *
+ * Every consumer is created up front, but only the first
+ * getActive() of them work; the rest sleep on a futex in park()
+ * until they are needed. A controller calls observe() every
+ * interval with how full the buffer is and how many times
+ * producers found it full and consumers found it empty since
+ * the last sample.
+ *
+ * Growing is quick and shrinking is slow, so a producer burst
+ * is met within a couple of samples, and idle consumers are only
+ * parked after the buffer has stayed nearly empty for a while:
+ *      -SCALE_UP_SAMPLES samples in a row of a buffer at least
+ *       SCALE_UP_OCCUPANCY full, or of producers finding it full
+ *       more often than consumers find it empty, add half again
+ *       as many consumers
+ *      -SCALE_DOWN_SAMPLES samples in a row of a buffer at most
+ *       SCALE_DOWN_OCCUPANCY full that no producer found full
+ *       park one consumer
+ * Anything in between resets both streaks, which keeps the pool
+ * from flapping around a threshold.
+ *
+ *****************************************************************/
+class ConsumerScaler {
+
+    const int firstId;                      // REF_ID of the first consumer
+    const int minimum;                      // fewest consumers kept working
+    const int maximum;                      // every consumer created
+    std::atomic<int> active;                // consumers working, the rest are parked
+    std::atomic<bool> stopped{false};
+    EventCount changed;                     // parked consumers sleep here until active grows
+
+    int upStreak = 0;                       // samples in a row calling for more consumers (controller only)
+    int downStreak = 0;                     // samples in a row calling for fewer consumers (controller only)
+    int peak;                               // most consumers ever active
+    long long scaleUps = 0;
+    long long scaleDowns = 0;
+
+    void setActive( const int COUNT ) {
+        active.store(COUNT, std::memory_order_release);
+        changed.notifyAll();
+    }
+
+    public:
+    /*****************************************
+     * ConsumerScaler Constructor
+     *
+     * @param FIRST_ID the REF_ID of the first consumer
+     * @param MINIMUM  the fewest consumers to keep working, and how many start
+     * @param MAXIMUM  the number of consumers created
+     *
+     ********************************************/
+    ConsumerScaler( const int FIRST_ID, const int MINIMUM, const int MAXIMUM )
+        : firstId(FIRST_ID), minimum(MINIMUM), maximum(MAXIMUM), active(MINIMUM), peak(MINIMUM) {}
+
+    // if the consumer REF_ID should be working right now
+    bool isActive( const int REF_ID ) const { return REF_ID - firstId < active.load(std::memory_order_acquire); }
+
+    // sleeps the consumer REF_ID until it is needed again, or stop() is called
+    void park( const int REF_ID ) {
+        while (!isActive(REF_ID) && !stopped.load(std::memory_order_acquire)) {
+            const uint32_t KEY = changed.prepareWait();
+            if (isActive(REF_ID) || stopped.load(std::memory_order_acquire)) {
+                changed.cancelWait();
+                return;
+            } //end if
+            changed.wait(KEY, LLONG_MAX);
+        } //end while
+    }
+
+    // wakes every parked consumer for good, so it can see the simulation ended
+    void stop() {
+        stopped.store(true, std::memory_order_release);
+        changed.notifyAll();
+    }
+
+    /*****************************************
+     * observe()
+     *
+     * @brief takes one sample and resizes the pool if it calls for it
+     *
+     * only ever called by the controller thread
+     *
+     * @param OCCUPANCY the fraction of the buffer's slots holding items
+     * @param FULLS     times producers found the buffer full since the last sample
+     * @param EMPTIES   times consumers found the buffer empty since the last sample
+     *
+     * @return the number of consumers active from now on
+     *****************************************/
+    int observe( const double OCCUPANCY, const long long FULLS, const long long EMPTIES ) {
+        const int ACTIVE = active.load(std::memory_order_relaxed);
+        const bool BEHIND = OCCUPANCY >= SCALE_UP_OCCUPANCY || FULLS > EMPTIES;
+        const bool IDLE = OCCUPANCY <= SCALE_DOWN_OCCUPANCY && FULLS == 0;
+        upStreak = BEHIND ? upStreak + 1 : 0;
+        downStreak = IDLE && !BEHIND ? downStreak + 1 : 0;
+
+        if (upStreak >= SCALE_UP_SAMPLES && ACTIVE < maximum) {
+            const int GROWN = ACTIVE + (ACTIVE / 2 > 1 ? ACTIVE / 2 : 1);
+            setActive(GROWN < maximum ? GROWN : maximum);
+            upStreak = 0;
+            scaleUps++;
+        } else if (downStreak >= SCALE_DOWN_SAMPLES && ACTIVE > minimum) {
+            setActive(ACTIVE - 1);
+            downStreak = 0;
+            scaleDowns++;
+        } //end else
+        const int NOW = active.load(std::memory_order_relaxed);
+        peak = NOW > peak ? NOW : peak;
+        return NOW;
+    }
+
+    // DISPLAY ACCESSORS //
+    int getFirstId() const { return firstId; }
+    int getActive() const { return active.load(std::memory_order_acquire); }
+    int getMinimum() const { return minimum; }
+    int getMaximum() const { return maximum; }
+    int getPeak() const { return peak; }
+    long long getScaleUps() const { return scaleUps; }
+    long long getScaleDowns() const { return scaleDowns; }
+};
+
+#endif // _AUTOSCALER_H_DEFINED_
@@ -16,13 +16,11 @@
 
 #ifndef _BUFFER_H_DEFINED_
 #define _BUFFER_H_DEFINED_
+#include <atomic>
 #include <iostream>
 #include <semaphore.h>
+#include "buffer_base.h"
 
-typedef int buffer_item;
-
-#define BUFFER_SIZE (5)
-#define NULL_ITEM (-1)
 /***************************************************************
  *
  * @brief a circular buffer to store items between two threads
@@ -33,19 +31,24 @@ typedef int buffer_item;
  * memory locations, it will wrap back to the beginning of its allocated
  * memory.
  *
+ * @tparam T        the type of item stored in the buffer
+ * @tparam Capacity number of slots, or DYNAMIC_CAPACITY to pick it
+ *                  when the buffer is constructed
+ *
  *****************************************************************/
-class Buffer {
+template<typename T = buffer_item, size_t Capacity = DYNAMIC_CAPACITY>
+class Buffer : public BufferBase<T> {
 
     public:
     // CLASS DATA MEMBERS //
     int size;                               // the number of items in the buffer
-    buffer_item buffer[BUFFER_SIZE]{};      // the place where items are stored
+    Ring<T, Capacity> buffer;               // the place where items are stored
     int head;                               // location of the oldest item
     int tail;                               // location of where the next item will go
 
     sem_t freeMutex{};                      // semaphore that keeps track if a thread is accessing the buffer
-    sem_t empty{};                          // semaphore that keeps track if there is something
-    sem_t full{};                           // semaphore that keeps track if something can be added to the buffer
+    std::atomic<int> empty;                 // how many empty slots producers can still reserve
+    std::atomic<int> full;                  // how many items consumers can still reserve
 
     /*****************************************
      * Buffer Constructor
@@ -57,17 +60,72 @@ class Buffer {
      * the buffer with a value to signify
      * empty (-1)
      *
+     * @param capacity  number of slots (only used with DYNAMIC_CAPACITY)
+     *
      ********************************************/
-    Buffer() : size(0), head(0), tail(0) {
-        for (int i = 0; i < BUFFER_SIZE; i++) { // NOLINT(*-loop-convert)
-            buffer[i] = NULL_ITEM;
+    explicit Buffer( size_t capacity = Capacity ? Capacity : BUFFER_SIZE )
+        : size(0), buffer(capacity), head(0), tail(0), empty((int)buffer.capacity()), full(0) {
+        for (size_t i = 0; i < buffer.capacity(); i++) {
+            buffer[i] = NullItem<T>::value();
         }
         sem_init(&freeMutex, 0, 1);
-        sem_init(&empty, 0, BUFFER_SIZE);
-        sem_init(&full, 0, 0);
     }
 
 
+    /*****************************************
+     * reserve()
+     *
+     * @brief takes up to WANT from a count without blocking
+     *
+     * the count works like a semaphore that can be taken from
+     * several at a time, but it never enters the kernel
+     *
+     * @param count **REFERENCE** empty or full
+     * @param WANT  the most to take
+     *
+     * @return how many were taken (0 if the count was 0)
+     *****************************************/
+    static size_t reserve( std::atomic<int> &count, const size_t WANT ) {
+        int available = count.load(std::memory_order_relaxed);
+        while (available > 0) {
+            const int TAKE = (size_t)available < WANT ? available : (int)WANT;
+            if (count.compare_exchange_weak(available, available - TAKE, std::memory_order_acquire, std::memory_order_relaxed))
+                return (size_t)TAKE;
+        } //end while
+        return 0;
+    }
+
+    // copies N items in after their slots have been reserved on empty
+    void putReserved( const T *items, const size_t N ) {
+        sem_wait(&freeMutex); // If there is no one is accessing the buffer
+        {
+            for (size_t i = 0; i < N; i++) {
+                buffer[tail] = items[i];
+                tail = (int)buffer.wrap(tail + 1);
+            } //end for
+            size += (int)N;
+        }
+        sem_post(&freeMutex);
+        full.fetch_add((int)N, std::memory_order_release);
+        this->notEmpty.notify(N);
+    }
+
+    // copies the N oldest items out after they have been reserved on full
+    void takeReserved( T *items, const size_t N ) {
+        sem_wait(&freeMutex); //If there is no one accessing the buffer
+        {
+            for (size_t i = 0; i < N; i++) {
+                items[i] = buffer[head];
+                buffer[head] = NullItem<T>::value();
+                head = (int)buffer.wrap(head + 1);
+            } //end for
+            size -= (int)N;
+        }
+        sem_post(&freeMutex);
+        empty.fetch_add((int)N, std::memory_order_release);
+        this->notFull.notify(N);
+    }
+
     /*****************************************
      * Buffer Insert Item
      *
@@ -81,7 +139,8 @@ class Buffer {
      * wrapping back to the beginning of the buffer
      * in memory
      *
-     * @pre         the buffer is not full
+     * Never blocks: a slot is reserved from empty,
+     * so the full check and the reservation are one step
      *
      * @param item  the item to be inserted into the buffer
      *
@@ -90,22 +149,11 @@ class Buffer {
      *                  (such as in the case of the buffer being full)
      *
      *****************************************/
-    bool buffer_insert_item( buffer_item item ) {
-        if (size == BUFFER_SIZE) // the buffer is full
+    bool buffer_insert_item( T item ) override {
+        if (reserve(empty, 1) == 0) // the buffer is full
             return false;
-        sem_wait(&empty); // If there is room in the buffer
-        {
-            sem_wait(&freeMutex); // If there is no one is accessing the buffer
-            {
-                buffer[tail] = item;
-                size++;
-                tail = (tail + 1) % BUFFER_SIZE;
-            }
-            sem_post(&freeMutex);
-        }
-        sem_post(&full);
+        putReserved(&item, 1);
         return true;
-
     }
 
 
@@ -118,7 +166,8 @@ class Buffer {
     * and replaces it with a null value (-1), but only if the buffer
     * is not empty.
     *
-    * @pre          the buffer is not empty
+    * Never blocks: an item is reserved from full,
+    * so the empty check and the reservation are one step
     *
     * @param item   REFERENCE to location the removed item will be stored to
     *
@@ -127,24 +176,101 @@ class Buffer {
     *                   (such as in the case of the buffer being empty)
     *
     *****************************************/
-    bool buffer_remove_item( buffer_item *item ) {
-        if (size == 0) //the buffer is empty
+    bool buffer_remove_item( T *item ) override {
+        if (reserve(full, 1) == 0) //the buffer is empty
             return false;
+        takeReserved(item, 1);
+        return true;
+    }
 
-        sem_wait(&full); //If there is something in the buffer
-        {
-            sem_wait(&freeMutex); //If there is no one accessing the buffer
-            {
-                *item = buffer[head];
-                buffer[head] = NULL_ITEM;
-                size--;
-                head = (head + 1) % BUFFER_SIZE;
-            }
+
+    /*****************************************
+     * Buffer Insert Items
+     *
+     * @brief  adds a run of items to the buffer
+     *
+     * reserves as many empty slots as it can get (up to n)
+     * with one update of empty, then copies the whole run into
+     * the buffer in one pass under freeMutex, wrapping around
+     * the end of the buffer if needed
+     *
+     * @param items the items to be inserted into the buffer
+     * @param n     the number of items
+     *
+     * @return      the number of items inserted (0 if the buffer was full)
+     *
+     *****************************************/
+    size_t buffer_insert_items( const T *items, size_t n ) override {
+        const size_t RESERVED = reserve(empty, n);
+        if (RESERVED > 0)
+            putReserved(items, RESERVED);
+        return RESERVED;
+    }
+
+
+    /*****************************************
+     * Buffer Remove Items
+     *
+     * @brief  removes a run of the oldest items from the buffer
+     *
+     * reserves as many filled slots as it can get (up to max)
+     * with one update of full, then copies the whole run out of
+     * the buffer in one pass under freeMutex, wrapping around
+     * the end of the buffer if needed
+     *
+     * @param items REFERENCE to where the removed items will be stored to
+     * @param max   the most items to remove
+     *
+     * @return      the number of items removed (0 if the buffer was empty)
+     *
+     *****************************************/
+    size_t buffer_remove_items( T *items, size_t max ) override {
+        const size_t RESERVED = reserve(full, max);
+        if (RESERVED > 0)
+            takeReserved(items, RESERVED);
+        return RESERVED;
+    }
+
+    /*****************************************
+     * Buffer Insert Overwriting
+     *
+     * @brief  adds an item to the buffer, writing it over the oldest
+     *         item if it is full
+     *
+     * If every slot holds an item, the oldest is replaced in place
+     * under freeMutex and head moves past it, so the counts on empty
+     * and full don't change and no consumer is involved. If the
+     * buffer only looks full because other threads have slots
+     * reserved but not yet filled / emptied, it tries again.
+     *
+     * @param item  the item to be inserted into the buffer
+     *
+     * @return      the number of items overwritten (0 or 1)
+     *
+     *****************************************/
+    size_t insert_overwriting( T item ) override {
+        while (reserve(empty, 1) == 0) {
+            sem_wait(&freeMutex);
+            if (size == (int)buffer.capacity()) { // every slot holds an item, replace the oldest
+                buffer[head] = item;
+                head = (int)buffer.wrap(head + 1);
+                tail = head;
+                sem_post(&freeMutex);
+                return 1;
+            } //end if
             sem_post(&freeMutex);
-        }
-        sem_post(&empty);
-        return true;
+            cpuRelax();
+        } //end while
+        putReserved(&item, 1);
+        return 0;
     }
+
+    // DISPLAY ACCESSORS //
+    int getCapacity() const override { return (int)buffer.capacity(); }
+    int getSize() const override { return size; }
+    int getHead() const override { return head; }
+    int getTail() const override { return tail; }
+    T getItem( int slot ) const override { return buffer[slot]; }
 };
 
 #endif // _BUFFER_H_DEFINED_
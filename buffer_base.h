@@ -0,0 +1,384 @@
+/**************************************************************************
+ *
+ *  Class Name: buffer_base.h
+ *  Purpose:    The common interface every buffer implementation shares so
+ *              that osproj4.cpp can swap between them at runtime, and the
+ *              ring storage they are all built on
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _BUFFER_BASE_H_DEFINED_
+#define _BUFFER_BASE_H_DEFINED_
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "wait_policy.h"
+
+#ifdef BUFFER_ITEM_64
+typedef uint64_t buffer_item;               // full range 64-bit items (empty slots hold all ones)
+#define BUFFER_ITEM_FORMAT "%5" PRIu64
+#else
+typedef int buffer_item;
+#define BUFFER_ITEM_FORMAT "%5d"
+#endif
+
+#define BUFFER_SIZE (5)             // default capacity when none is given on the command line
+#define DYNAMIC_CAPACITY (0)        // Capacity template argument for a buffer sized at runtime
+#define NULL_ITEM (-1)
+#define CACHE_LINE_SIZE (64)        // alignment that keeps independently written data off each other's cache line
+
+/***************************************************************
+ *
+ * @brief the value an empty slot of a buffer holds
+ *
+ * Defaults to NULL_ITEM (-1) converted to the item type.
+ * Specialize for item types that can't be built from an int.
+ *
+ *****************************************************************/
+template<typename T>
+struct NullItem {
+    static T value() { return T(NULL_ITEM); }
+};
+
+/***************************************************************
+ *
+ * @brief fixed size storage that wraps positions around its end
+ *
+ * Buffers count positions upward forever and let the Ring turn a
+ * position into the slot it lands on. When the capacity is known
+ * at compile time the slots live inline, and a power-of-two
+ * capacity wraps with a mask instead of a division.
+ *
+ *****************************************************************/
+template<typename U, size_t Capacity>
+class Ring {
+
+    std::array<U, Capacity> slots{};        // the place where items are stored
+
+    public:
+    explicit Ring( size_t capacity = Capacity ) { (void)capacity; }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // the slot a position lands on
+    static constexpr size_t wrap( size_t position ) {
+        if constexpr ((Capacity & (Capacity - 1)) == 0)
+            return position & (Capacity - 1);
+        else
+            return position % Capacity;
+    }
+
+    U& operator[]( size_t slot ) { return slots[slot]; }
+    const U& operator[]( size_t slot ) const { return slots[slot]; }
+};
+
+/***************************************************************
+ *
+ * @brief a Ring whose capacity is picked at runtime
+ *
+ * Slots live on the heap. Power-of-two capacities still wrap
+ * with a mask; any other capacity falls back to a division.
+ *
+ *****************************************************************/
+template<typename U>
+class Ring<U, DYNAMIC_CAPACITY> {
+
+    size_t size;                            // the number of slots
+    bool powerOfTwo;                        // if positions can be wrapped with a mask
+    std::unique_ptr<U[]> slots;             // the place where items are stored
+
+    public:
+    explicit Ring( size_t capacity )
+        : size(capacity), powerOfTwo((capacity & (capacity - 1)) == 0),
+          slots(new U[capacity]()) {}
+
+    size_t capacity() const { return size; }
+
+    // the slot a position lands on
+    size_t wrap( size_t position ) const {
+        return powerOfTwo ? position & (size - 1) : position % size;
+    }
+
+    U& operator[]( size_t slot ) { return slots[slot]; }
+    const U& operator[]( size_t slot ) const { return slots[slot]; }
+};
+
+/***************************************************************
+ *
+ * @brief the insert / remove contract of a circular buffer
+ *
+ * Every buffer the simulation can run on derives from this class.
+ * Producers and consumers only ever talk to a BufferBase, so the
+ * backing implementation (semaphores, lock-free, ...) can be picked
+ * from the command line without touching the thread code.
+ *
+ * Every operation comes in three flavors:
+ *      -try_insert / try_remove never block, and fail if the buffer
+ *       is full / empty at the moment they take effect
+ *      -insert / remove block until there is room / an item
+ *      -insert_until / remove_until block, but give up at a deadline
+ * Blocking calls also give up once the buffer is closed, which is
+ * how main() stops threads that are waiting on it.
+ *
+ * Blocked threads wait on notFull / notEmpty with whatever strategy
+ * setWaitStrategy() picked. Implementations notify notEmpty after
+ * every insert and notFull after every remove.
+ *
+ *****************************************************************/
+template<typename T>
+class BufferBase {
+
+    std::atomic<bool> closed{false};        // set once by close(), ends every blocking call
+
+    protected:
+    WaitPolicy notFull;                     // producers waiting for room wait here
+    WaitPolicy notEmpty;                    // consumers waiting for an item wait here
+
+    public:
+    virtual ~BufferBase() = default;
+
+    /*****************************************
+     * Buffer Insert Item
+     *
+     * @brief  adds an item to the buffer without blocking
+     *
+     * @param item  the item to be inserted into the buffer
+     *
+     * @return      true if the item was successfully inserted into the buffer
+     * @return     false if the buffer was full
+     *
+     *****************************************/
+    virtual bool buffer_insert_item( T item ) = 0;
+
+    /*****************************************
+     * Buffer Remove Item
+     *
+     * @brief  removes the oldest item from the buffer without blocking
+     *
+     * @param item   REFERENCE to location the removed item will be stored to
+     *
+     * @return       true if the item was successfully removed from the buffer
+     * @return       false if the buffer was empty
+     *
+     *****************************************/
+    virtual bool buffer_remove_item( T *item ) = 0;
+
+    bool try_insert( T item ) { return buffer_insert_item(item); }
+    bool try_remove( T *item ) { return buffer_remove_item(item); }
+    bool insert( T item ) { return insert_until(item, NO_DEADLINE); }
+    bool remove( T *item ) { return remove_until(item, NO_DEADLINE); }
+
+    /*****************************************
+     * Buffer Insert Until
+     *
+     * @brief  adds an item to the buffer, waiting for room
+     *
+     * @param item      the item to be inserted into the buffer
+     * @param DEADLINE  nowNanoseconds() time to give up at (NO_DEADLINE waits for good)
+     *
+     * @return      true if the item was inserted
+     * @return     false if the deadline passed or the buffer was closed first
+     *
+     *****************************************/
+    virtual bool insert_until( T item, const long long DEADLINE ) {
+        return buffer_insert_item(item)
+            || notFull.waitUntil(DEADLINE, [&] { return buffer_insert_item(item); }, [&] { return isClosed(); });
+    }
+
+    /*****************************************
+     * Buffer Remove Until
+     *
+     * @brief  removes the oldest item from the buffer, waiting for one
+     *
+     * @param item      REFERENCE to location the removed item will be stored to
+     * @param DEADLINE  nowNanoseconds() time to give up at (NO_DEADLINE waits for good)
+     *
+     * @return      true if an item was removed
+     * @return     false if the deadline passed or the buffer was closed first
+     *
+     *****************************************/
+    virtual bool remove_until( T *item, const long long DEADLINE ) {
+        return buffer_remove_item(item)
+            || notEmpty.waitUntil(DEADLINE, [&] { return buffer_remove_item(item); }, [&] { return isClosed(); });
+    }
+
+    /*****************************************
+     * Buffer Insert Items Until / Remove Items Until
+     *
+     * @brief  the batch operations below, waiting until at least
+     *         one item moves
+     *
+     * @return the number of items moved (0 if the deadline passed
+     *         or the buffer was closed first)
+     *****************************************/
+    virtual size_t insert_items_until( const T *items, size_t n, const long long DEADLINE ) {
+        size_t inserted = buffer_insert_items(items, n);
+        if (inserted == 0 && n > 0)
+            notFull.waitUntil(DEADLINE, [&] { return (inserted = buffer_insert_items(items, n)) > 0; }, [&] { return isClosed(); });
+        return inserted;
+    }
+
+    virtual size_t remove_items_until( T *items, size_t max, const long long DEADLINE ) {
+        size_t removed = buffer_remove_items(items, max);
+        if (removed == 0 && max > 0)
+            notEmpty.waitUntil(DEADLINE, [&] { return (removed = buffer_remove_items(items, max)) > 0; }, [&] { return isClosed(); });
+        return removed;
+    }
+
+    /*****************************************
+     * Buffer Insert Evicting
+     *
+     * @brief  adds an item to the buffer, removing the oldest items
+     *         to make room if it is full
+     *
+     * never waits on consumers, so the item always goes in; the
+     * items removed to make room are thrown away
+     *
+     * @param item  the item to be inserted into the buffer
+     *
+     * @return      the number of items evicted (0 if there was room)
+     *
+     *****************************************/
+    virtual size_t insert_evicting( T item ) {
+        size_t evicted = 0;
+        T oldest;
+        while (!buffer_insert_item(item)) {
+            if (buffer_remove_item(&oldest)) // a consumer may have made room first
+                evicted++;
+        } //end while
+        return evicted;
+    }
+
+    /*****************************************
+     * Buffer Insert Overwriting
+     *
+     * @brief  adds an item to the buffer, writing it over the oldest
+     *         item if it is full, like a lossy ring
+     *
+     * implementations that can replace the oldest item in one step
+     * override this; the default evicts it first
+     *
+     * @param item  the item to be inserted into the buffer
+     *
+     * @return      the number of items overwritten (0 if there was room)
+     *
+     *****************************************/
+    virtual size_t insert_overwriting( T item ) { return insert_evicting(item); }
+
+    /*****************************************
+     * close()
+     *
+     * @brief wakes every thread blocked on the buffer and makes
+     *        blocking calls give up from now on
+     *
+     * the non-blocking calls keep working, so whatever is left
+     * in the buffer can still be counted or drained; buffers with
+     * more places to wait on than notFull / notEmpty wake those too
+     *****************************************/
+    virtual void close() {
+        closed.store(true, std::memory_order_release);
+        notFull.wakeAll();
+        notEmpty.wakeAll();
+    }
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+    /*****************************************
+     * forThread()
+     *
+     * @brief the buffer a particular thread should call
+     *
+     * lets a buffer made of parts hand each thread the part
+     * it works with; a plain buffer is the same for everyone
+     *
+     * @param INDEX the thread's number
+     *
+     * @return the buffer that thread should insert into / remove from
+     *****************************************/
+    virtual BufferBase<T>* forThread( const int INDEX ) { (void)INDEX; return this; }
+
+    /*****************************************
+     * forLane()
+     *
+     * @brief the buffer to insert items of a priority lane through
+     *
+     * a buffer without lanes takes every item the same way
+     *
+     * @param LANE the lane, 0 for the lowest priority
+     *
+     * @return the buffer items of that lane should be inserted into
+     *****************************************/
+    virtual BufferBase<T>* forLane( const int LANE ) { (void)LANE; return this; }
+
+    // how blocked threads wait, set before any thread uses the buffer
+    virtual void setWaitStrategy( const WaitStrategy STRATEGY ) {
+        notFull.setStrategy(STRATEGY);
+        notEmpty.setStrategy(STRATEGY);
+    }
+
+    /*****************************************
+     * Buffer Insert Items
+     *
+     * @brief  adds a run of items to the buffer
+     *
+     * inserts as many of the given items as there is room
+     * for, in order. Implementations override this to claim
+     * the whole run with one synchronization; the default
+     * just inserts them one at a time.
+     *
+     * @param items the items to be inserted into the buffer
+     * @param n     the number of items
+     *
+     * @return      the number of items inserted (0 if the buffer was full)
+     *
+     *****************************************/
+    virtual size_t buffer_insert_items( const T *items, size_t n ) {
+        size_t inserted = 0;
+        while (inserted < n && buffer_insert_item(items[inserted]))
+            inserted++;
+        return inserted;
+    }
+
+    /*****************************************
+     * Buffer Remove Items
+     *
+     * @brief  removes a run of the oldest items from the buffer
+     *
+     * removes up to max items, oldest first. Implementations
+     * override this to claim the whole run with one
+     * synchronization; the default just removes them one
+     * at a time.
+     *
+     * @param items REFERENCE to where the removed items will be stored to
+     * @param max   the most items to remove
+     *
+     * @return      the number of items removed (0 if the buffer was empty)
+     *
+     *****************************************/
+    virtual size_t buffer_remove_items( T *items, size_t max ) {
+        size_t removed = 0;
+        while (removed < max && buffer_remove_item(&items[removed]))
+            removed++;
+        return removed;
+    }
+
+    // DISPLAY ACCESSORS //
+    // these are only used to print the buffer, and may be a
+    // slightly stale snapshot while other threads are running
+    virtual int getCapacity() const = 0;                // the number of slots in the buffer
+    virtual int getSize() const = 0;                    // the number of items in the buffer
+    virtual int getHead() const = 0;                    // location of the oldest item
+    virtual int getTail() const = 0;                    // location of where the next item will go
+    virtual T getItem( int slot ) const = 0;            // the item stored at a slot (NULL_ITEM if empty)
+};
+
+#endif // _BUFFER_BASE_H_DEFINED_
@@ -0,0 +1,547 @@
+/**************************************************************************
+ *
+ *  Class Name: buffer_bench.cpp
+ *  Purpose:    Measures how fast each buffer implementation moves items
+ *              between threads. Sweeps producer / consumer counts,
+ *              capacity and batch size, and reports throughput, per-call
+ *              latency percentiles and run-to-run variance as a table
+ *              and (optionally) a CSV file. Also times multi-KB messages
+ *              moved as move-only pointers or as slab handles
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <pthread.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "buffer_factory.h"
+#include "options.h"
+#include "payload_buffer.h"
+#include "thread_stats.h"
+using namespace std;
+
+
+#define LATENCY_SAMPLE_EVERY (16)           // time one call out of this many, so the clock doesn't dominate
+#define UNSTICK_AFTER_NS (100000000LL)      // how long to wait for threads to stop before draining the buffer for them
+#define MESSAGE_BYTES (4096)                // size of the messages the payload and slab backends move
+
+/**** BENCHMARK TYPES ****/
+// a message too big to copy around cheaply
+struct Message {
+    uint64_t sequence;
+    char body[MESSAGE_BYTES - sizeof(uint64_t)];
+};
+
+// one point of the sweep
+struct BenchConfig {
+    string backend;
+    int producers;
+    int consumers;
+    size_t capacity;
+    size_t batch;
+};
+
+// what one thread did during a run, padded so threads don't share a cache line
+struct alignas(CACHE_LINE_SIZE) Worker {
+    BufferBase<buffer_item> *buffer;
+    PayloadBuffer<unique_ptr<Message>> *payloads;   // with the payload backend, each message is its own allocation
+    PayloadSlab<Message> *slab;                     // with the slab backend, messages are reused in place
+    size_t batch;
+    const atomic<bool> *running;
+    atomic<int> *finished;
+    long long items;                        // items this thread moved
+    uint64_t checksum;                      // sum of the message sequence numbers read, so the reads aren't optimized out
+    vector<uint32_t> latencies;             // nanoseconds taken by a sample of successful calls
+};
+
+// everything measured over the repeats of one BenchConfig
+struct BenchResult {
+    vector<double> opsPerSecond;            // items consumed per second, one per run
+    vector<uint32_t> latencies;             // every sampled call of every run
+};
+
+/**** FUNCTION HEADERS ****/
+void* benchProducer(void *param);
+void* benchConsumer(void *param);
+void* payloadProducer(void *param);
+void* payloadConsumer(void *param);
+void* slabProducer(void *param);
+void* slabConsumer(void *param);
+void runOnce(const BenchConfig &CONFIG, long long durationNanoseconds, BenchResult &result);
+uint32_t percentile(const vector<uint32_t> &SORTED, double fraction);
+
+
+/*****************************************
+ * main()
+ *
+ * @brief runs every combination of the requested settings
+ *        and prints how each one performed
+ *
+ * **every parameter is optional, lists are comma separated
+ * @param --backends=list      buffer implementations to test (DEFAULT: semaphore,lockfree,spsc),
+ *                             payload and slab move 4 KiB messages instead (batch 1 only)
+ * @param --producers=list     producer thread counts (DEFAULT: 1,4)
+ * @param --consumers=list     consumer thread counts (DEFAULT: 1,4)
+ * @param --capacity=list      buffer capacities (DEFAULT: 64,1024)
+ * @param --batch=list         items moved per call (DEFAULT: 1,32)
+ * @param --runs=int           repeats of each combination (DEFAULT: 3)
+ * @param --duration-ms=int    length of each run in milliseconds (DEFAULT: 100)
+ * @param --csv=path           also write the results to a CSV file
+ *
+ * @return       0        benchmark completed
+ * @return       1        Invalid Arguments
+ *
+ *****************************************/
+int main(int argc, char* argv[]) {
+
+    string invalidArgMsg = "INVALID ARGUMENTS!!\n"
+                           "All parameters are optional, lists are comma separated:\n"
+                                "\t--backends=list  Buffer implementations (DEFAULT: semaphore,lockfree,spsc, also payload,slab)\n"
+                                "\t--producers=list  Producer thread counts (DEFAULT: 1,4)\n"
+                                "\t--consumers=list  Consumer thread counts (DEFAULT: 1,4)\n"
+                                "\t--capacity=list  Buffer capacities (DEFAULT: 64,1024)\n"
+                                "\t--batch=list  Items moved per call (DEFAULT: 1,32)\n"
+                                "\t--runs=int  Repeats of each combination (DEFAULT: 3)\n"
+                                "\t--duration-ms=int  Length of each run in milliseconds (DEFAULT: 100)\n"
+                                "\t--csv=path  Also write the results to a CSV file\n\n";
+
+    ///READ USER ARGUMENTS
+    vector<string> backends = {"semaphore", "lockfree", "spsc"};
+    vector<long long> producers = {1, 4};
+    vector<long long> consumers = {1, 4};
+    vector<long long> capacities = {64, 1024};
+    vector<long long> batches = {1, 32};
+    int runs = 3;
+    long long durationMs = 100;
+    string csvPath;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value;
+        if ((value = optionValue(argv[i], "--backends")) != nullptr) {
+            backends = splitList(value);
+        } else if ((value = optionValue(argv[i], "--producers")) != nullptr) {
+            producers = splitNumbers(value);
+        } else if ((value = optionValue(argv[i], "--consumers")) != nullptr) {
+            consumers = splitNumbers(value);
+        } else if ((value = optionValue(argv[i], "--capacity")) != nullptr) {
+            capacities = splitNumbers(value);
+        } else if ((value = optionValue(argv[i], "--batch")) != nullptr) {
+            batches = splitNumbers(value);
+        } else if ((value = optionValue(argv[i], "--runs")) != nullptr) {
+            runs = atoi(value);
+        } else if ((value = optionValue(argv[i], "--duration-ms")) != nullptr) {
+            durationMs = atoll(value);
+        } else if ((value = optionValue(argv[i], "--csv")) != nullptr) {
+            csvPath = value;
+        } else { // unknown option
+            printf("%s", invalidArgMsg.c_str());
+            return 1;
+        } //end else
+    } //end for
+
+    //every count must be positive
+    bool valid = runs > 0 && durationMs > 0 && !backends.empty();
+    for (const vector<long long> *list : {&producers, &consumers, &capacities, &batches}) {
+        valid = valid && !list->empty() && *min_element(list->begin(), list->end()) > 0;
+    } //end for
+    if (!valid) {
+        printf("%s", invalidArgMsg.c_str());
+        return 1;
+    } //end if
+
+    FILE *csv = nullptr;
+    if (!csvPath.empty()) {
+        csv = fopen(csvPath.c_str(), "w");
+        if (csv == nullptr) {
+            perror(csvPath.c_str());
+            return 1;
+        } //end if
+        fprintf(csv, "backend,producers,consumers,capacity,batch,runs,mops_mean,mops_stddev,cv_percent,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n");
+    } //end if
+
+    ///RUN THE SWEEP
+    printf("%-10s %4s %4s %8s %6s %10s %9s %7s %8s %8s %8s %9s %9s\n",
+           "backend", "prod", "cons", "capacity", "batch", "Mops/s", "stddev", "cv%",
+           "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+
+    for (const string &BACKEND : backends) {
+        for (const long long P : producers) {
+            for (const long long C : consumers) {
+                for (const long long CAPACITY : capacities) {
+                    for (const long long BATCH : batches) {
+                        const BenchConfig CONFIG = {BACKEND, (int)P, (int)C, (size_t)CAPACITY, (size_t)BATCH};
+
+                        //skip combinations the backend can't run (such as spsc with several threads)
+                        if (BACKEND == "payload" || BACKEND == "slab") {
+                            if (CONFIG.batch > 1) // messages only move one at a time
+                                continue;
+                        } else {
+                            BufferBase<buffer_item> *probe = makeBuffer<buffer_item>(BACKEND, CONFIG.capacity, CONFIG.producers, CONFIG.consumers);
+                            if (probe == nullptr)
+                                continue;
+                            delete probe;
+                        } //end else
+
+                        BenchResult result;
+                        for (int run = 0; run < runs; run++) {
+                            runOnce(CONFIG, durationMs * 1000000LL, result);
+                        } //end for
+
+                        //throughput mean and spread between runs
+                        double mean = 0, variance = 0;
+                        for (const double OPS : result.opsPerSecond) {
+                            mean += OPS;
+                        } //end for
+                        mean /= (double)runs;
+                        for (const double OPS : result.opsPerSecond) {
+                            variance += (OPS - mean) * (OPS - mean);
+                        } //end for
+                        const double STDDEV = runs > 1 ? sqrt(variance / (runs - 1)) : 0;
+                        const double CV = mean > 0 ? 100.0 * STDDEV / mean : 0;
+
+                        sort(result.latencies.begin(), result.latencies.end());
+                        const uint32_t P50 = percentile(result.latencies, 0.50);
+                        const uint32_t P90 = percentile(result.latencies, 0.90);
+                        const uint32_t P99 = percentile(result.latencies, 0.99);
+                        const uint32_t P999 = percentile(result.latencies, 0.999);
+                        const uint32_t MAX = result.latencies.empty() ? 0 : result.latencies.back();
+
+                        printf("%-10s %4d %4d %8zu %6zu %10.3f %9.3f %7.2f %8u %8u %8u %9u %9u\n",
+                               BACKEND.c_str(), CONFIG.producers, CONFIG.consumers, CONFIG.capacity, CONFIG.batch,
+                               mean / 1e6, STDDEV / 1e6, CV, P50, P90, P99, P999, MAX);
+                        fflush(stdout);
+                        if (csv != nullptr) {
+                            fprintf(csv, "%s,%d,%d,%zu,%zu,%d,%.6f,%.6f,%.3f,%u,%u,%u,%u,%u\n",
+                                    BACKEND.c_str(), CONFIG.producers, CONFIG.consumers, CONFIG.capacity, CONFIG.batch,
+                                    runs, mean / 1e6, STDDEV / 1e6, CV, P50, P90, P99, P999, MAX);
+                        } //end if
+                    } //end for
+                } //end for
+            } //end for
+        } //end for
+    } //end for
+
+    if (csv != nullptr)
+        fclose(csv);
+    return 0;
+} //end main
+
+/*****************************************
+ * runOnce()
+ *
+ * @brief runs one timed round of a BenchConfig
+ *
+ * Starts every producer and consumer on a fresh buffer, lets them
+ * move items flat out for the duration, then stops them. Backends
+ * whose calls can block are drained until every thread has
+ * noticed the stop. The payload and slab backends never block.
+ *
+ * @param CONFIG              **REFERENCE** the settings to run
+ * @param durationNanoseconds how long to let the threads run
+ * @param result              **REFERENCE** where the run's throughput and latencies are added
+ *
+ * @return void
+ *****************************************/
+void runOnce(const BenchConfig &CONFIG, const long long durationNanoseconds, BenchResult &result) {
+    BufferBase<buffer_item> *buffer = nullptr;
+    PayloadBuffer<unique_ptr<Message>> *payloads = nullptr;
+    PayloadSlab<Message> *slab = nullptr;
+    void *(*produce)(void *) = benchProducer;
+    void *(*consume)(void *) = benchConsumer;
+    if (CONFIG.backend == "payload") {
+        payloads = new PayloadBuffer<unique_ptr<Message>>(CONFIG.capacity);
+        produce = payloadProducer;
+        consume = payloadConsumer;
+    } else if (CONFIG.backend == "slab") {
+        slab = new PayloadSlab<Message>(CONFIG.capacity);
+        produce = slabProducer;
+        consume = slabConsumer;
+    } else {
+        buffer = makeBuffer<buffer_item>(CONFIG.backend, CONFIG.capacity, CONFIG.producers, CONFIG.consumers);
+    } //end else
+    atomic<bool> running(true);
+    atomic<int> finished(0);
+
+    const int TOTAL_THREADS = CONFIG.producers + CONFIG.consumers;
+    vector<Worker> workers(TOTAL_THREADS);
+    vector<pthread_t> tid(TOTAL_THREADS);
+    for (int i = 0; i < TOTAL_THREADS; i++) {
+        workers[i].buffer = buffer;
+        workers[i].payloads = payloads;
+        workers[i].slab = slab;
+        workers[i].batch = CONFIG.batch;
+        workers[i].running = &running;
+        workers[i].finished = &finished;
+        workers[i].items = 0;
+        workers[i].checksum = 0;
+        pthread_create(&tid[i], nullptr, i < CONFIG.producers ? produce : consume, &workers[i]);
+    } //end for
+
+    const long long START = nowNanoseconds();
+    timespec duration = {(time_t)(durationNanoseconds / 1000000000LL), (long)(durationNanoseconds % 1000000000LL)};
+    clock_nanosleep(CLOCK_MONOTONIC, 0, &duration, nullptr);
+    running = false;
+    const long long ELAPSED = nowNanoseconds() - START;
+
+    //a thread stuck waiting on a full / empty buffer needs someone else to move an item
+    vector<buffer_item> scratch(CONFIG.capacity);
+    while (finished.load() < TOTAL_THREADS) {
+        if (buffer != nullptr && nowNanoseconds() - START - ELAPSED > UNSTICK_AFTER_NS) {
+            buffer->buffer_remove_items(scratch.data(), scratch.size());
+            buffer->buffer_insert_items(scratch.data(), 1);
+        } //end if
+        sched_yield();
+    } //end while
+
+    long long consumed = 0;
+    for (int i = 0; i < TOTAL_THREADS; i++) {
+        pthread_join(tid[i], nullptr);
+        if (i >= CONFIG.producers)
+            consumed += workers[i].items;
+        result.latencies.insert(result.latencies.end(), workers[i].latencies.begin(), workers[i].latencies.end());
+    } //end for
+    result.opsPerSecond.push_back((double)consumed * 1e9 / (double)ELAPSED);
+
+    delete buffer;
+    delete payloads;
+    delete slab;
+} //end runOnce
+
+/*****************************************
+ * benchProducer()
+ *
+ * @brief inserts items as fast as the buffer takes them
+ *
+ * @param param the thread's Worker
+ *
+ * @return nullptr when the run is over
+ *****************************************/
+void* benchProducer(void *param) {
+    Worker &worker = *static_cast<Worker *>(param);
+    vector<buffer_item> items(worker.batch);
+    for (size_t i = 0; i < worker.batch; i++) {
+        items[i] = (buffer_item)i;
+    } //end for
+
+    unsigned calls = 0;
+    while (worker.running->load(memory_order_relaxed)) {
+        const bool SAMPLE = ++calls % LATENCY_SAMPLE_EVERY == 0;
+        const long long START = SAMPLE ? nowNanoseconds() : 0;
+
+        size_t inserted;
+        if (worker.batch == 1)
+            inserted = worker.buffer->buffer_insert_item(items[0]) ? 1 : 0;
+        else
+            inserted = worker.buffer->buffer_insert_items(items.data(), worker.batch);
+
+        if (SAMPLE && inserted > 0)
+            worker.latencies.push_back((uint32_t)(nowNanoseconds() - START));
+        worker.items += (long long)inserted;
+    } //end while
+
+    worker.finished->fetch_add(1);
+    return nullptr;
+} //end benchProducer
+
+/*****************************************
+ * benchConsumer()
+ *
+ * @brief removes items as fast as the buffer gives them
+ *
+ * @param param the thread's Worker
+ *
+ * @return nullptr when the run is over
+ *****************************************/
+void* benchConsumer(void *param) {
+    Worker &worker = *static_cast<Worker *>(param);
+    vector<buffer_item> items(worker.batch);
+
+    unsigned calls = 0;
+    while (worker.running->load(memory_order_relaxed)) {
+        const bool SAMPLE = ++calls % LATENCY_SAMPLE_EVERY == 0;
+        const long long START = SAMPLE ? nowNanoseconds() : 0;
+
+        size_t removed;
+        if (worker.batch == 1)
+            removed = worker.buffer->buffer_remove_item(&items[0]) ? 1 : 0;
+        else
+            removed = worker.buffer->buffer_remove_items(items.data(), worker.batch);
+
+        if (SAMPLE && removed > 0)
+            worker.latencies.push_back((uint32_t)(nowNanoseconds() - START));
+        worker.items += (long long)removed;
+    } //end while
+
+    worker.finished->fetch_add(1);
+    return nullptr;
+} //end benchConsumer
+
+/*****************************************
+ * payloadProducer()
+ *
+ * @brief allocates messages and moves them into a PayloadBuffer
+ *        as fast as it takes them
+ *
+ * a message that didn't fit is kept for the next try, so only
+ * messages that went in cost an allocation
+ *
+ * @param param the thread's Worker
+ *
+ * @return nullptr when the run is over
+ *****************************************/
+void* payloadProducer(void *param) {
+    Worker &worker = *static_cast<Worker *>(param);
+    unique_ptr<Message> message;
+    uint64_t sequence = 0;
+
+    unsigned calls = 0;
+    while (worker.running->load(memory_order_relaxed)) {
+        const bool SAMPLE = ++calls % LATENCY_SAMPLE_EVERY == 0;
+        const long long START = SAMPLE ? nowNanoseconds() : 0;
+
+        if (message == nullptr) {
+            message.reset(new Message);
+            message->sequence = sequence++;
+        } //end if
+        const bool INSERTED = worker.payloads->try_insert(std::move(message));
+
+        if (SAMPLE && INSERTED)
+            worker.latencies.push_back((uint32_t)(nowNanoseconds() - START));
+        worker.items += INSERTED;
+    } //end while
+
+    worker.finished->fetch_add(1);
+    return nullptr;
+} //end payloadProducer
+
+/*****************************************
+ * payloadConsumer()
+ *
+ * @brief moves messages out of a PayloadBuffer and frees them
+ *
+ * @param param the thread's Worker
+ *
+ * @return nullptr when the run is over
+ *****************************************/
+void* payloadConsumer(void *param) {
+    Worker &worker = *static_cast<Worker *>(param);
+    unique_ptr<Message> message;
+
+    unsigned calls = 0;
+    while (worker.running->load(memory_order_relaxed)) {
+        const bool SAMPLE = ++calls % LATENCY_SAMPLE_EVERY == 0;
+        const long long START = SAMPLE ? nowNanoseconds() : 0;
+
+        const bool REMOVED = worker.payloads->try_remove(&message);
+        if (REMOVED) {
+            worker.checksum += message->sequence;
+            message.reset();
+        } //end if
+
+        if (SAMPLE && REMOVED)
+            worker.latencies.push_back((uint32_t)(nowNanoseconds() - START));
+        worker.items += REMOVED;
+    } //end while
+
+    worker.finished->fetch_add(1);
+    return nullptr;
+} //end payloadConsumer
+
+/*****************************************
+ * slabProducer()
+ *
+ * @brief fills messages in place in a PayloadSlab and publishes
+ *        their handles as fast as free messages come back
+ *
+ * @param param the thread's Worker
+ *
+ * @return nullptr when the run is over
+ *****************************************/
+void* slabProducer(void *param) {
+    Worker &worker = *static_cast<Worker *>(param);
+    slab_handle handle;
+    uint64_t sequence = 0;
+
+    unsigned calls = 0;
+    while (worker.running->load(memory_order_relaxed)) {
+        const bool SAMPLE = ++calls % LATENCY_SAMPLE_EVERY == 0;
+        const long long START = SAMPLE ? nowNanoseconds() : 0;
+
+        const bool ACQUIRED = worker.slab->try_acquire(&handle);
+        if (ACQUIRED) {
+            (*worker.slab)[handle].sequence = sequence++;
+            worker.slab->publish(handle);
+        } //end if
+
+        if (SAMPLE && ACQUIRED)
+            worker.latencies.push_back((uint32_t)(nowNanoseconds() - START));
+        worker.items += ACQUIRED;
+    } //end while
+
+    worker.finished->fetch_add(1);
+    return nullptr;
+} //end slabProducer
+
+/*****************************************
+ * slabConsumer()
+ *
+ * @brief takes published handles out of a PayloadSlab, reads
+ *        the messages in place and releases them
+ *
+ * @param param the thread's Worker
+ *
+ * @return nullptr when the run is over
+ *****************************************/
+void* slabConsumer(void *param) {
+    Worker &worker = *static_cast<Worker *>(param);
+    slab_handle handle;
+
+    unsigned calls = 0;
+    while (worker.running->load(memory_order_relaxed)) {
+        const bool SAMPLE = ++calls % LATENCY_SAMPLE_EVERY == 0;
+        const long long START = SAMPLE ? nowNanoseconds() : 0;
+
+        const bool REMOVED = worker.slab->try_remove(&handle);
+        if (REMOVED) {
+            worker.checksum += (*worker.slab)[handle].sequence;
+            worker.slab->release(handle);
+        } //end if
+
+        if (SAMPLE && REMOVED)
+            worker.latencies.push_back((uint32_t)(nowNanoseconds() - START));
+        worker.items += REMOVED;
+    } //end while
+
+    worker.finished->fetch_add(1);
+    return nullptr;
+} //end slabConsumer
+
+/*****************************************
+ * percentile()
+ *
+ * @brief reads a percentile out of sorted samples
+ *
+ * @param SORTED   **REFERENCE** the samples, smallest first
+ * @param fraction which percentile, from 0 to 1
+ *
+ * @return the sample at that percentile (0 if there are none)
+ *****************************************/
+uint32_t percentile(const vector<uint32_t> &SORTED, const double fraction) {
+    if (SORTED.empty())
+        return 0;
+    size_t index = (size_t)(fraction * (double)SORTED.size());
+    if (index >= SORTED.size())
+        index = SORTED.size() - 1;
+    return SORTED[index];
+} //end percentile
@@ -0,0 +1,129 @@
+/**************************************************************************
+ *
+ *  Class Name: buffer_factory.h
+ *  Purpose:    Builds whichever buffer implementation is named on the
+ *              command line, so every program picks backends the same way
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _BUFFER_FACTORY_H_DEFINED_
+#define _BUFFER_FACTORY_H_DEFINED_
+#include <memory>
+#include <string>
+#include <vector>
+#include "buffer.h"
+#include "lockfree_buffer.h"
+#include "priority_buffer.h"
+#include "shared_buffer.h"
+#include "sharded_buffer.h"
+#include "spsc_buffer.h"
+
+#define BUFFER_BACKENDS "semaphore|lockfree|spsc"
+
+/*****************************************
+ * makeBuffer()
+ *
+ * @brief creates a buffer by the name of its backend
+ *
+ * With more than one shard, the slots are split evenly across
+ * that many buffers of the backend, joined by a ShardedBuffer.
+ * With more than one lane, every lane gets a buffer of the
+ * backend with all of the slots, joined by a PriorityBuffer, so a
+ * full lane never keeps items out of another.
+ *
+ * @param BACKEND       semaphore, lockfree or spsc
+ * @param CAPACITY      number of slots in the buffer
+ * @param NUM_PRODUCERS how many threads will insert
+ * @param NUM_CONSUMERS how many threads will remove
+ * @param SHARDS        how many shards to split the buffer into
+ * @param LANES         how many priority lanes the buffer has
+ * @param CREDIT_LIMIT  removes a waiting lane lets higher lanes take before it is served
+ *
+ * @return a new buffer the caller owns
+ * @return nullptr if BACKEND is unknown, or is spsc with more
+ *         than one producer / consumer or more than one shard,
+ *         or the buffer is asked for both shards and lanes
+ *****************************************/
+template<typename T>
+BufferBase<T>* makeBuffer(const std::string &BACKEND, const size_t CAPACITY, const int NUM_PRODUCERS, const int NUM_CONSUMERS,
+                          const int SHARDS = 1, const int LANES = 1, const long long CREDIT_LIMIT = PRIORITY_LANE_CREDIT) {
+    if (LANES > 1) { // a lane is inserted into as a whole, so sharding it would only ever fill its first shard
+        if (SHARDS > 1 || LANES > PRIORITY_MAX_LANES)
+            return nullptr;
+        std::vector<std::unique_ptr<BufferBase<T>>> lanes;
+        for (int i = 0; i < LANES; i++) {
+            BufferBase<T> *lane = makeBuffer<T>(BACKEND, CAPACITY, NUM_PRODUCERS, NUM_CONSUMERS);
+            if (lane == nullptr)
+                return nullptr;
+            lanes.emplace_back(lane);
+        } //end for
+        return new PriorityBuffer<T>(std::move(lanes), CREDIT_LIMIT);
+    } //end if
+
+    if (SHARDS > 1) { // consumers steal across shards, so every shard needs to take many consumers
+        if (BACKEND == "spsc")
+            return nullptr;
+        const size_t SHARD_CAPACITY = (CAPACITY + SHARDS - 1) / SHARDS;
+        std::vector<std::unique_ptr<BufferBase<T>>> shards;
+        for (int i = 0; i < SHARDS; i++) {
+            BufferBase<T> *shard = makeBuffer<T>(BACKEND, SHARD_CAPACITY, NUM_PRODUCERS, NUM_CONSUMERS);
+            if (shard == nullptr)
+                return nullptr;
+            shards.emplace_back(shard);
+        } //end for
+        return new ShardedBuffer<T>(std::move(shards));
+    } //end if
+
+    if (BACKEND == "semaphore")
+        return new Buffer<T>(CAPACITY);
+    if (BACKEND == "lockfree")
+        return new LockFreeBuffer<T>(CAPACITY);
+    if (BACKEND == "spsc" && NUM_PRODUCERS == 1 && NUM_CONSUMERS == 1)
+        return new SPSCBuffer<T>(CAPACITY);
+    return nullptr;
+} //end makeBuffer
+
+/*****************************************
+ * makeSharedBuffer()
+ *
+ * @brief creates or attaches to a buffer in named shared memory
+ *
+ * @param NAME     the shared memory name both processes use
+ * @param CAPACITY number of slots, if this process creates it
+ *
+ * @return a new buffer the caller owns
+ * @return nullptr if the segment couldn't be opened or holds
+ *         a different item type
+ *****************************************/
+template<typename T>
+BufferBase<T>* makeSharedBuffer(const std::string &NAME, const size_t CAPACITY) {
+    SharedBuffer<T> *shared = new SharedBuffer<T>(NAME, CAPACITY);
+    if (!shared->isAttached()) {
+        delete shared;
+        return nullptr;
+    } //end if
+    return shared;
+} //end makeSharedBuffer
+
+/*****************************************
+ * defaultBackend()
+ *
+ * @brief the backend to use when none is named
+ *
+ * a single producer and consumer don't need to fight
+ * over the buffer, so they get the wait-free one
+ *
+ * @return the name of the backend
+ *****************************************/
+inline std::string defaultBackend(const int NUM_PRODUCERS, const int NUM_CONSUMERS) {
+    return (NUM_PRODUCERS == 1 && NUM_CONSUMERS == 1) ? "spsc" : "semaphore";
+} //end defaultBackend
+
+#endif // _BUFFER_FACTORY_H_DEFINED_
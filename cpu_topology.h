@@ -0,0 +1,256 @@
+/**************************************************************************
+ *
+ *  Class Name: cpu_topology.h
+ *  Purpose:    Finds out how the machine's CPUs are laid out (hyperthreads,
+ *              cores, sockets) and decides which CPU each producer and
+ *              consumer thread in osproj4.cpp is pinned to
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _CPU_TOPOLOGY_H_DEFINED_
+#define _CPU_TOPOLOGY_H_DEFINED_
+#include <algorithm>
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <string>
+#include <vector>
+#include "options.h"
+
+#define CPU_SYSFS "/sys/devices/system/cpu"
+
+enum ThreadPlacement {
+    PLACE_NONE,                             // let the scheduler put threads anywhere
+    PLACE_COMPACT,                          // fill every hyperthread of a core, then the next core
+    PLACE_SCATTER,                          // one thread per core, alternating sockets, before doubling up
+    PLACE_PAIRS,                            // producer i and consumer i on two hyperthreads of one core
+    PLACE_LIST                              // round robin over a list of CPUs from the command line
+};
+
+// one CPU the process is allowed to run on
+struct LogicalCpu {
+    int cpu;                                // the number the kernel knows it by
+    int core;                               // core_id, shared by hyperthreads of one core
+    int package;                            // physical_package_id, shared by every core of a socket
+    int thread;                             // which hyperthread of its core it is, from 0
+};
+
+/***************************************************************
+ *
+ * @brief the CPUs this process may run on and how they relate
+ *
+ * Built from /sys/devices/system/cpu, restricted to the CPUs in
+ * the process's affinity mask (so taskset and cgroup limits are
+ * respected). If the topology files can't be read, every allowed
+ * CPU is treated as its own core on one socket.
+ *
+ *****************************************************************/
+class CpuTopology {
+
+    std::vector<LogicalCpu> cpus;           // sorted by package, then core, then thread
+
+    // reads a single number out of a sysfs file
+    static int readNumber( const std::string &PATH, const int FALLBACK ) {
+        std::ifstream file(PATH);
+        int number;
+        return (file >> number) ? number : FALLBACK;
+    }
+
+    public:
+    /*****************************************
+     * discover()
+     *
+     * @brief reads the topology of the machine
+     *
+     * @param ROOT where the kernel's cpu directory is
+     *
+     * @return the topology of every CPU the process may use
+     *****************************************/
+    static CpuTopology discover( const std::string &ROOT = CPU_SYSFS ) {
+        CpuTopology topology;
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+            return topology;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (!CPU_ISSET(cpu, &allowed))
+                continue;
+            const std::string DIRECTORY = ROOT + "/cpu" + std::to_string(cpu) + "/topology/";
+            topology.cpus.push_back({cpu, readNumber(DIRECTORY + "core_id", cpu),
+                                     readNumber(DIRECTORY + "physical_package_id", 0), 0});
+        } //end for
+
+        std::sort(topology.cpus.begin(), topology.cpus.end(), []( const LogicalCpu &A, const LogicalCpu &B ) {
+            if (A.package != B.package) return A.package < B.package;
+            if (A.core != B.core) return A.core < B.core;
+            return A.cpu < B.cpu;
+        });
+        for (size_t i = 1; i < topology.cpus.size(); i++) { // number the hyperthreads of each core
+            LogicalCpu &cpu = topology.cpus[i];
+            const LogicalCpu &PREVIOUS = topology.cpus[i - 1];
+            if (cpu.package == PREVIOUS.package && cpu.core == PREVIOUS.core)
+                cpu.thread = PREVIOUS.thread + 1;
+        } //end for
+        return topology;
+    }
+
+    size_t size() const { return cpus.size(); }
+    bool contains( const int CPU ) const {
+        return std::any_of(cpus.begin(), cpus.end(), [&]( const LogicalCpu &LOGICAL ) { return LOGICAL.cpu == CPU; });
+    }
+
+    // each core's hyperthreads, cores in package order
+    std::vector<std::vector<int>> cores() const {
+        std::vector<std::vector<int>> grouped;
+        for (size_t i = 0; i < cpus.size(); i++) {
+            if (cpus[i].thread == 0)
+                grouped.emplace_back();
+            grouped.back().push_back(cpus[i].cpu);
+        } //end for
+        return grouped;
+    }
+
+    // CPUs in the order compact placement fills them: sibling hyperthreads next to each other
+    std::vector<int> compactOrder() const {
+        std::vector<int> order;
+        for (const LogicalCpu &CPU : cpus)
+            order.push_back(CPU.cpu);
+        return order;
+    }
+
+    // CPUs in the order scatter placement fills them: the first hyperthread of
+    // every core (taking a core from each socket in turn), then the second, ...
+    std::vector<int> scatterOrder() const {
+        std::vector<std::vector<std::vector<int>>> packages; // package -> core -> hyperthreads
+        int lastPackage = -1;
+        for (const std::vector<int> &CORE : cores()) {
+            const int PACKAGE = std::find_if(cpus.begin(), cpus.end(), [&]( const LogicalCpu &LOGICAL ) {
+                return LOGICAL.cpu == CORE[0];
+            })->package;
+            if (PACKAGE != lastPackage)
+                packages.emplace_back();
+            lastPackage = PACKAGE;
+            packages.back().push_back(CORE);
+        } //end for
+
+        std::vector<int> order;
+        for (size_t thread = 0; order.size() < cpus.size(); thread++) {
+            for (size_t core = 0; order.size() < cpus.size(); core++) {
+                bool any = false;
+                for (const auto &PACKAGE : packages) {
+                    if (core < PACKAGE.size()) {
+                        any = true;
+                        if (thread < PACKAGE[core].size())
+                            order.push_back(PACKAGE[core][thread]);
+                    } //end if
+                } //end for
+                if (!any)
+                    break;
+            } //end for
+        } //end for
+        return order;
+    }
+
+    // a short description for the final statistics
+    std::string describe() const {
+        int packages = 0;
+        for (size_t i = 0; i < cpus.size(); i++) {
+            if (i == 0 || cpus[i].package != cpus[i - 1].package)
+                packages++;
+        } //end for
+        return std::to_string(cpus.size()) + " CPUs, " + std::to_string(cores().size()) + " cores, "
+               + std::to_string(packages) + (packages == 1 ? " socket" : " sockets");
+    }
+};
+
+/*****************************************
+ * parsePlacement()
+ *
+ * @brief reads a placement name from the command line
+ *
+ * @param NAME   none, compact, scatter or pairs
+ * @param result REFERENCE to where the placement is stored
+ *
+ * @return true if NAME is a known placement
+ *****************************************/
+inline bool parsePlacement( const std::string &NAME, ThreadPlacement &result ) {
+    if (NAME == "none") result = PLACE_NONE;
+    else if (NAME == "compact") result = PLACE_COMPACT;
+    else if (NAME == "scatter") result = PLACE_SCATTER;
+    else if (NAME == "pairs") result = PLACE_PAIRS;
+    else return false;
+    return true;
+} //end parsePlacement
+
+/*****************************************
+ * placeThreads()
+ *
+ * @brief picks the CPU for every producer and consumer
+ *
+ * threads are numbered in the order main() creates them,
+ * producers first, then consumers
+ *
+ * @param PLACEMENT     how to spread the threads
+ * @param TOPOLOGY      the CPUs there are to use
+ * @param NUM_PRODUCERS how many producers there are
+ * @param NUM_CONSUMERS how many consumers there are
+ * @param LIST          the CPUs for PLACE_LIST
+ *
+ * @return the CPU of each thread (-1 to leave it unpinned)
+ *****************************************/
+inline std::vector<int> placeThreads( const ThreadPlacement PLACEMENT, const CpuTopology &TOPOLOGY, const int NUM_PRODUCERS,
+                                      const int NUM_CONSUMERS, const std::vector<int> &LIST ) {
+    const size_t THREADS = (size_t)(NUM_PRODUCERS + NUM_CONSUMERS);
+    std::vector<int> placed(THREADS, -1);
+    if (PLACEMENT == PLACE_NONE || TOPOLOGY.size() == 0)
+        return placed;
+
+    if (PLACEMENT == PLACE_PAIRS) { // the i-th producer and the i-th consumer share a core
+        const std::vector<std::vector<int>> CORES = TOPOLOGY.cores();
+        for (int i = 0; i < NUM_PRODUCERS; i++) {
+            const std::vector<int> &CORE = CORES[(size_t)i % CORES.size()];
+            placed[i] = CORE[0];
+        } //end for
+        for (int i = 0; i < NUM_CONSUMERS; i++) {
+            const std::vector<int> &CORE = CORES[(size_t)i % CORES.size()];
+            placed[NUM_PRODUCERS + i] = CORE[1 % CORE.size()];
+        } //end for
+        return placed;
+    } //end if
+
+    const std::vector<int> ORDER = PLACEMENT == PLACE_LIST ? LIST
+                                 : PLACEMENT == PLACE_SCATTER ? TOPOLOGY.scatterOrder() : TOPOLOGY.compactOrder();
+    for (size_t i = 0; i < THREADS && !ORDER.empty(); i++) {
+        placed[i] = ORDER[i % ORDER.size()];
+    } //end for
+    return placed;
+} //end placeThreads
+
+/*****************************************
+ * pinToCpu()
+ *
+ * @brief makes threads created with an attribute run only on one CPU
+ *
+ * @param attr REFERENCE to the attribute threads are created with
+ * @param CPU  the CPU to run on (-1 leaves the attribute unpinned)
+ *
+ * @return true if the attribute was set (or left unpinned)
+ *****************************************/
+inline bool pinToCpu( pthread_attr_t *attr, const int CPU ) {
+    if (CPU < 0)
+        return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(CPU, &set);
+    return pthread_attr_setaffinity_np(attr, sizeof(set), &set) == 0;
+} //end pinToCpu
+
+#endif // _CPU_TOPOLOGY_H_DEFINED_
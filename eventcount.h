@@ -0,0 +1,147 @@
+/**************************************************************************
+ *
+ *  Class Name: eventcount.h
+ *  Purpose:    A futex-backed wait / notify primitive that only enters the
+ *              kernel when some thread is actually waiting, used by the
+ *              buffers for their not-full / not-empty conditions
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _EVENTCOUNT_H_DEFINED_
+#define _EVENTCOUNT_H_DEFINED_
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/***************************************************************
+ *
+ * @brief an eventcount: a waiter count plus an epoch a thread
+ *        can sleep on until it changes
+ *
+ * A thread that finds its condition false (the buffer is full,
+ * say) waits like this:
+ *
+ *      key = prepareWait();
+ *      if (condition is now true) { cancelWait(); ... }
+ *      else wait(key, deadline);
+ *
+ * and a thread that makes the condition true calls notifyOne()
+ * or notifyAll() afterwards. Notifying only touches the epoch and
+ * makes the futex system call when the waiter count says someone
+ * is registered, so the uncontended path stays in user space.
+ * Registering before the recheck means a notify can never slip
+ * in between the check and the sleep unnoticed: it either sees
+ * the waiter and bumps the epoch, or the recheck sees its change.
+ *
+ * Both sides normally fence so they can't miss each other. A
+ * buffer notifies on every insert and remove but rarely waits, so
+ * it can build its events with HEAVY_WAIT to have the waiter pay
+ * instead: prepareWait() makes an expedited membarrier, which puts
+ * a full fence into every running thread of the process, and
+ * notify() only needs the compiler not to move its read of
+ * waiters. That membarrier interrupts every CPU running one of the
+ * process's threads, so events that are waited on about as often
+ * as they are notified (the start gate, parked consumers) keep the
+ * plain fences. Without expedited membarriers both sides fence.
+ *
+ * An EventCount placed in memory shared between processes has to
+ * be built process-shared, so the kernel matches waiters by the
+ * page rather than by one process's address space. A membarrier
+ * can't reach the other processes, so shared ones always fence.
+ *
+ *****************************************************************/
+class EventCount {
+
+    std::atomic<uint32_t> epoch{0};         // futex word, bumped by every notify that has someone to wake
+    std::atomic<uint32_t> waiters{0};       // threads between prepareWait() and the end of wait() / cancelWait()
+    int scope;                              // FUTEX_PRIVATE_FLAG, or 0 when shared between processes
+    bool heavyWait;                         // prepareWait() makes a membarrier so notify() can skip its fence
+
+    // true once this process can make expedited membarriers, registered the first time it is asked
+    static bool registerMembarrier() {
+        static const bool REGISTERED = syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+        return REGISTERED;
+    }
+
+    long futex( std::atomic<uint32_t> *word, const int OPERATION, const uint32_t VALUE, const timespec *TIMEOUT ) const {
+        return syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), OPERATION | scope, VALUE, TIMEOUT, nullptr,
+                       FUTEX_BITSET_MATCH_ANY);
+    }
+
+    // wakes up to COUNT waiters, if there are any
+    void notify( const int COUNT ) {
+        if (heavyWait) // a waiter's membarrier orders the caller's change for us
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        else
+            std::atomic_thread_fence(std::memory_order_seq_cst); // order the caller's change before reading waiters
+        if (waiters.load(std::memory_order_relaxed) == 0)
+            return;
+        epoch.fetch_add(1, std::memory_order_release);
+        futex(&epoch, FUTEX_WAKE, (uint32_t)COUNT, nullptr);
+    }
+
+    public:
+    /*****************************************
+     * EventCount Constructor
+     *
+     * @param PROCESS_SHARED true when it lives in memory shared between processes
+     * @param HEAVY_WAIT     true to move notify()'s fence into prepareWait(), for
+     *                       events notified far more often than waited on
+     *
+     ********************************************/
+    explicit EventCount( const bool PROCESS_SHARED = false, const bool HEAVY_WAIT = false )
+        : scope(PROCESS_SHARED ? 0 : FUTEX_PRIVATE_FLAG), heavyWait(HEAVY_WAIT && !PROCESS_SHARED && registerMembarrier()) {}
+
+    // registers the caller as a waiter, returns the key to wait() on
+    uint32_t prepareWait() {
+        waiters.fetch_add(1, std::memory_order_relaxed);
+        if (heavyWait) // fences every running thread, so a notify either sees this waiter or its change is seen
+            syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+        else
+            std::atomic_thread_fence(std::memory_order_seq_cst); // order the registration before the caller's recheck
+        return epoch.load(std::memory_order_acquire);
+    }
+
+    // unregisters a caller that found its condition true after prepareWait()
+    void cancelWait() { waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+    /*****************************************
+     * wait()
+     *
+     * @brief sleeps until a notify after prepareWait(), or a deadline
+     *
+     * may also return early (a signal, or a notify meant for another
+     * waiter), so callers always recheck their condition
+     *
+     * @param KEY      what prepareWait() returned
+     * @param DEADLINE CLOCK_MONOTONIC nanoseconds to give up at, LLONG_MAX for never
+     *****************************************/
+    void wait( const uint32_t KEY, const long long DEADLINE ) {
+        if (DEADLINE == LLONG_MAX) {
+            futex(&epoch, FUTEX_WAIT_BITSET, KEY, nullptr);
+        } else {
+            timespec wake{};
+            wake.tv_sec = DEADLINE / 1000000000LL;
+            wake.tv_nsec = DEADLINE % 1000000000LL;
+            futex(&epoch, FUTEX_WAIT_BITSET, KEY, &wake); // absolute time on CLOCK_MONOTONIC
+        } //end else
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notifyOne() { notify(1); }
+    void notifyAll() { notify(INT_MAX); }
+};
+
+#endif // _EVENTCOUNT_H_DEFINED_
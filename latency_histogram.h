@@ -0,0 +1,115 @@
+/**************************************************************************
+ *
+ *  Class Name: latency_histogram.h
+ *  Purpose:    Records how long items sat in the buffer, from the moment
+ *              a producer inserted them to the moment a consumer took them
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _LATENCY_HISTOGRAM_H_DEFINED_
+#define _LATENCY_HISTOGRAM_H_DEFINED_
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define HISTOGRAM_SUB_BITS (5)                                  // 2^5 = 32 sub-buckets per power of two, about 3% precision
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS ((64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_BUCKETS) // 2 rows below 64, then one per power of two up to 2^63
+
+/***************************************************************
+ *
+ * @brief a log-linear (HDR style) histogram of nanosecond latencies
+ *
+ * Values below 64 get a bucket each. Above that, every power of two
+ * is split into 32 equal buckets, so any value is recorded to
+ * within about 3% with a fixed 15KB of counters (1920 of them),
+ * no matter how large it is, up to the largest 64-bit value.
+ *
+ * Each consumer records into its own histogram, and they are
+ * merged once the threads have stopped, so recording is a plain
+ * increment with no sharing.
+ *
+ *****************************************************************/
+class LatencyHistogram {
+
+    std::vector<uint64_t> counts;           // number of values recorded in each bucket
+    uint64_t total;                         // number of values recorded
+    uint64_t largest;                       // largest value recorded
+
+    static size_t bucketOf( const uint64_t VALUE ) {
+        if (VALUE < 2 * HISTOGRAM_SUB_BUCKETS)
+            return (size_t)VALUE;
+        const int EXPONENT = 63 - __builtin_clzll(VALUE);
+        const int SHIFT = EXPONENT - HISTOGRAM_SUB_BITS;
+        return (size_t)SHIFT * HISTOGRAM_SUB_BUCKETS + (size_t)(VALUE >> SHIFT);
+    }
+
+    // the smallest value that lands in a bucket
+    static uint64_t lowestIn( const size_t BUCKET ) {
+        if (BUCKET < 2 * HISTOGRAM_SUB_BUCKETS)
+            return BUCKET;
+        const size_t SHIFT = BUCKET / HISTOGRAM_SUB_BUCKETS - 1;
+        return (uint64_t)(BUCKET % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS) << SHIFT;
+    }
+
+    public:
+    LatencyHistogram() : counts(HISTOGRAM_BUCKETS, 0), total(0), largest(0) {}
+
+    void record( const uint64_t NANOSECONDS ) {
+        counts[bucketOf(NANOSECONDS)]++;
+        total++;
+        if (NANOSECONDS > largest)
+            largest = NANOSECONDS;
+    }
+
+    // adds every value recorded by another histogram to this one
+    void merge( const LatencyHistogram &OTHER ) {
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            counts[i] += OTHER.counts[i];
+        } //end for
+        total += OTHER.total;
+        if (OTHER.largest > largest)
+            largest = OTHER.largest;
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return largest; }
+
+    /*****************************************
+     * percentile()
+     *
+     * @brief the latency below which a fraction of values fall
+     *
+     * @param FRACTION which percentile, from 0 to 1
+     *
+     * @return the midpoint of the bucket holding that percentile
+     *         (never more than the largest value recorded)
+     *****************************************/
+    uint64_t percentile( const double FRACTION ) const {
+        if (total == 0)
+            return 0;
+        uint64_t rank = (uint64_t)(FRACTION * (double)total);
+        if (rank >= total)
+            rank = total - 1;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            seen += counts[i];
+            if (seen > rank) {
+                const uint64_t LOW = lowestIn(i);
+                const uint64_t MIDPOINT = LOW + (lowestIn(i + 1) - LOW) / 2;
+                return MIDPOINT < largest ? MIDPOINT : largest;
+            } //end if
+        } //end for
+        return largest;
+    }
+};
+
+#endif // _LATENCY_HISTOGRAM_H_DEFINED_
@@ -0,0 +1,266 @@
+/**************************************************************************
+ *
+ *  Class Name: lockfree_buffer.h
+ *  Purpose:    A lock-free circular buffer that interacts with osproj4.cpp
+ *              Any number of producers and consumers can add and take
+ *              items without ever waiting on a semaphore
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _LOCKFREE_BUFFER_H_DEFINED_
+#define _LOCKFREE_BUFFER_H_DEFINED_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "buffer_base.h"
+
+/***************************************************************
+ *
+ * @brief a multi-producer / multi-consumer lock-free circular buffer
+ *
+ * Every slot carries a sequence number that says whose turn it is
+ * to use the slot. A producer claims the slot at tail by moving tail
+ * forward with a compare-and-swap, writes its item, then bumps the
+ * slot's sequence so the consumer for that lap may read it. Consumers
+ * do the same on head. Threads only collide when they race for the
+ * same slot, and a failed CAS just retries on the next one.
+ *
+ * Keeps the same contract as Buffer: inserting into a full buffer
+ * and removing from an empty buffer return false instead of waiting.
+ *
+ * @tparam T        the type of item stored in the buffer
+ * @tparam Capacity number of slots, or DYNAMIC_CAPACITY to pick it
+ *                  when the buffer is constructed
+ *
+ *****************************************************************/
+template<typename T = buffer_item, size_t Capacity = DYNAMIC_CAPACITY>
+class LockFreeBuffer : public BufferBase<T> {
+
+    struct Slot {
+        std::atomic<size_t> sequence;       // lap number of the thread allowed to use this slot next
+        T item;                             // the item stored in this slot
+    };
+
+    // CLASS DATA MEMBERS //
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;  // position of where the next item will go
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;  // position of the oldest item
+    alignas(CACHE_LINE_SIZE) Ring<Slot, Capacity> buffer;   // the place where items are stored
+
+    public:
+    /*****************************************
+     * LockFreeBuffer Constructor
+     *
+     * @brief constructor for a LockFreeBuffer
+     *
+     * sets head and tail to 0, gives each slot
+     * the sequence of the first producer that
+     * will write to it, and fills the buffer
+     * with a value to signify empty (-1)
+     *
+     * @param capacity  number of slots (only used with DYNAMIC_CAPACITY)
+     *
+     ********************************************/
+    explicit LockFreeBuffer( size_t capacity = Capacity ? Capacity : BUFFER_SIZE ) : tail(0), head(0), buffer(capacity) {
+        for (size_t i = 0; i < buffer.capacity(); i++) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+            buffer[i].item = NullItem<T>::value();
+        }
+    }
+
+
+    /*****************************************
+     * Buffer Insert Item
+     *
+     * @brief  adds an item to the buffer without locking
+     *
+     * claims the slot at tail if its sequence says it has
+     * been emptied for this lap, stores the item, then
+     * publishes it to consumers by advancing the sequence
+     *
+     * @param item  the item to be inserted into the buffer
+     *
+     * @return      true if the item was successfully inserted into the buffer
+     * @return     false if the buffer was full
+     *
+     *****************************************/
+    bool buffer_insert_item( T item ) override {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true) {
+            slot = &buffer[buffer.wrap(position)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t lap = (intptr_t)sequence - (intptr_t)position;
+
+            if (lap == 0) { // slot is free for this position, try to claim it
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (lap < 0) { // slot still holds last lap's item, the buffer is full
+                return false;
+            } else { // another producer claimed this position first
+                position = tail.load(std::memory_order_relaxed);
+            } //end else
+        } //end while
+
+        slot->item = item;
+        slot->sequence.store(position + 1, std::memory_order_release);
+        this->notEmpty.notify(1);
+        return true;
+    }
+
+
+    /*****************************************
+    * Buffer Remove Item
+    *
+    * @brief  removes the oldest item from the buffer without locking
+    *
+    * claims the slot at head if its sequence says a producer has
+    * filled it for this lap, takes the item, replaces it with a
+    * null value (-1), and hands the slot to the producer of the
+    * next lap
+    *
+    * @param item   REFERENCE to location the removed item will be stored to
+    *
+    * @return       true if the item was successfully removed from the buffer
+    * @return       false if the buffer was empty
+    *
+    *****************************************/
+    bool buffer_remove_item( T *item ) override {
+        size_t position = head.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true) {
+            slot = &buffer[buffer.wrap(position)];
+            const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const intptr_t lap = (intptr_t)sequence - (intptr_t)(position + 1);
+
+            if (lap == 0) { // slot is filled for this position, try to claim it
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (lap < 0) { // no producer has filled this slot yet, the buffer is empty
+                return false;
+            } else { // another consumer claimed this position first
+                position = head.load(std::memory_order_relaxed);
+            } //end else
+        } //end while
+
+        *item = slot->item;
+        slot->item = NullItem<T>::value();
+        slot->sequence.store(position + buffer.capacity(), std::memory_order_release);
+        this->notFull.notify(1);
+        return true;
+    }
+
+
+    /*****************************************
+     * Buffer Insert Items
+     *
+     * @brief  adds a run of items to the buffer with one CAS
+     *
+     * counts how many slots starting at tail are free for this
+     * lap (up to n), claims all of them by moving tail forward
+     * once, then fills and publishes each one. A run never
+     * skips a busy slot, so it may come up shorter than n.
+     *
+     * @param items the items to be inserted into the buffer
+     * @param n     the number of items
+     *
+     * @return      the number of items inserted (0 if the buffer was full)
+     *
+     *****************************************/
+    size_t buffer_insert_items( const T *items, size_t n ) override {
+        size_t position = tail.load(std::memory_order_relaxed);
+        size_t run;
+        while (true) {
+            //count the free slots in a row at tail
+            for (run = 0; run < n && run < buffer.capacity(); run++) {
+                const size_t sequence = buffer[buffer.wrap(position + run)].sequence.load(std::memory_order_acquire);
+                if (sequence != position + run)
+                    break;
+            } //end for
+
+            if (run > 0) { // try to claim the whole run
+                if (tail.compare_exchange_weak(position, position + run, std::memory_order_relaxed))
+                    break;
+            } else if ((intptr_t)buffer[buffer.wrap(position)].sequence.load(std::memory_order_acquire) - (intptr_t)position < 0) {
+                return 0; // slot at tail still holds last lap's item, the buffer is full
+            } else { // another producer claimed this position first
+                position = tail.load(std::memory_order_relaxed);
+            } //end else
+        } //end while
+
+        for (size_t i = 0; i < run; i++) {
+            Slot &slot = buffer[buffer.wrap(position + i)];
+            slot.item = items[i];
+            slot.sequence.store(position + i + 1, std::memory_order_release);
+        } //end for
+        this->notEmpty.notify(run);
+        return run;
+    }
+
+
+    /*****************************************
+     * Buffer Remove Items
+     *
+     * @brief  removes a run of the oldest items with one CAS
+     *
+     * counts how many slots starting at head have been filled
+     * for this lap (up to max), claims all of them by moving
+     * head forward once, then empties each one and hands it to
+     * the producer of the next lap
+     *
+     * @param items REFERENCE to where the removed items will be stored to
+     * @param max   the most items to remove
+     *
+     * @return      the number of items removed (0 if the buffer was empty)
+     *
+     *****************************************/
+    size_t buffer_remove_items( T *items, size_t max ) override {
+        size_t position = head.load(std::memory_order_relaxed);
+        size_t run;
+        while (true) {
+            //count the filled slots in a row at head
+            for (run = 0; run < max && run < buffer.capacity(); run++) {
+                const size_t sequence = buffer[buffer.wrap(position + run)].sequence.load(std::memory_order_acquire);
+                if (sequence != position + run + 1)
+                    break;
+            } //end for
+
+            if (run > 0) { // try to claim the whole run
+                if (head.compare_exchange_weak(position, position + run, std::memory_order_relaxed))
+                    break;
+            } else if ((intptr_t)buffer[buffer.wrap(position)].sequence.load(std::memory_order_acquire) - (intptr_t)(position + 1) < 0) {
+                return 0; // no producer has filled the slot at head yet, the buffer is empty
+            } else { // another consumer claimed this position first
+                position = head.load(std::memory_order_relaxed);
+            } //end else
+        } //end while
+
+        for (size_t i = 0; i < run; i++) {
+            Slot &slot = buffer[buffer.wrap(position + i)];
+            items[i] = slot.item;
+            slot.item = NullItem<T>::value();
+            slot.sequence.store(position + i + buffer.capacity(), std::memory_order_release);
+        } //end for
+        this->notFull.notify(run);
+        return run;
+    }
+
+    // DISPLAY ACCESSORS //
+    int getCapacity() const override { return (int)buffer.capacity(); }
+    int getSize() const override {
+        const size_t first = head.load(std::memory_order_relaxed);
+        const size_t last = tail.load(std::memory_order_relaxed);
+        return last > first ? (int)(last - first) : 0;
+    }
+    int getHead() const override { return (int)buffer.wrap(head.load(std::memory_order_relaxed)); }
+    int getTail() const override { return (int)buffer.wrap(tail.load(std::memory_order_relaxed)); }
+    T getItem( int slot ) const override { return buffer[slot].item; }
+};
+
+#endif // _LOCKFREE_BUFFER_H_DEFINED_
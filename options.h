@@ -0,0 +1,113 @@
+/**************************************************************************
+ *
+ *  Class Name: options.h
+ *  Purpose:    Helpers for reading the optional "--name=value" command
+ *              line arguments shared by osproj4.cpp and buffer_bench.cpp
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _OPTIONS_H_DEFINED_
+#define _OPTIONS_H_DEFINED_
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/*****************************************
+ * optionValue()
+ *
+ * @brief reads the value out of an optional "--name=value" argument
+ *
+ * @param ARG  the command line argument being checked
+ * @param NAME the name of the option, including its leading dashes
+ *
+ * @return the text after the '=' if ARG is the option NAME
+ * @return nullptr if ARG is some other option
+ *****************************************/
+inline const char* optionValue(const char *ARG, const char *NAME) {
+    const size_t NAME_LENGTH = strlen(NAME);
+    if (strncmp(ARG, NAME, NAME_LENGTH) != 0 || ARG[NAME_LENGTH] != '=')
+        return nullptr;
+    return ARG + NAME_LENGTH + 1;
+} //end optionValue
+
+/*****************************************
+ * splitList()
+ *
+ * @brief splits a comma separated option value into its parts
+ *
+ * @param VALUE the text after the '=' of an option
+ *
+ * @return each non-empty part, in order
+ *****************************************/
+inline std::vector<std::string> splitList(const char *VALUE) {
+    std::vector<std::string> parts;
+    std::string part;
+    for (const char *c = VALUE; ; c++) {
+        if (*c == ',' || *c == '\0') {
+            if (!part.empty())
+                parts.push_back(part);
+            part.clear();
+            if (*c == '\0')
+                break;
+        } else {
+            part += *c;
+        } //end else
+    } //end for
+    return parts;
+} //end splitList
+
+/*****************************************
+ * splitNumbers()
+ *
+ * @brief splits a comma separated list of numbers
+ *
+ * @param VALUE the text after the '=' of an option
+ *
+ * @return each number, in order (unparseable parts read as 0)
+ *****************************************/
+inline std::vector<long long> splitNumbers(const char *VALUE) {
+    std::vector<long long> numbers;
+    for (const std::string &PART : splitList(VALUE)) {
+        numbers.push_back(atoll(PART.c_str()));
+    } //end for
+    return numbers;
+} //end splitNumbers
+
+/*****************************************
+ * splitRanges()
+ *
+ * @brief expands a list of numbers and ranges, like "0-3,8,10-11"
+ *
+ * the same format Linux uses for lists of CPUs
+ *
+ * @param VALUE the text to expand
+ *
+ * @return each number, in order
+ * @return an empty list if any part is not a number or a range
+ *****************************************/
+inline std::vector<int> splitRanges(const char *VALUE) {
+    std::vector<int> numbers;
+    for (const std::string &PART : splitList(VALUE)) {
+        char *end;
+        const long FIRST = strtol(PART.c_str(), &end, 10);
+        long last = FIRST;
+        if (*end == '-')
+            last = strtol(end + 1, &end, 10);
+        if (end == PART.c_str() || (*end != '\0' && *end != '\n') || FIRST < 0 || last < FIRST)
+            return {};
+        for (long number = FIRST; number <= last; number++) {
+            numbers.push_back((int)number);
+        } //end for
+    } //end for
+    return numbers;
+} //end splitRanges
+
+#endif // _OPTIONS_H_DEFINED_
@@ -16,48 +16,135 @@
 
 #include <cstring>
 
-#include "buffer.h"
+#include "buffer_factory.h"
+#include "options.h"
+#include "thread_stats.h"
+#include "primes.h"
+#include "prime_kernel.h"
+#include "xoshiro.h"
+#include "think_time.h"
+#include "cpu_topology.h"
+#include "async_logger.h"
+#include "stamped_item.h"
+#include "latency_histogram.h"
+#include "trace.h"
+#include "start_gate.h"
+#include "autoscaler.h"
+#include <limits.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <iostream>
 #include <unistd.h>
 #include <random>
 #include <string>
+#include <algorithm>
 #include <atomic>
+#include <vector>
 using namespace std;
 
 
-#define MAX_THREADS 25
 #define MAX_RANDOM_NUMBER 100
-#define PRODUCER_TAG 1
-#define CONSUMER_TAG 2
+#define WAIT_NANOSECONDS (1000000LL)
+#define THREAD_STACK_KB (256)             //stack each producer / consumer gets; they keep everything big on the heap
+#define THREADS_PER_SPAWNER (128)         //threads one spawner creates before it is worth starting another
+
+//how a thread acts when the buffer is full / empty
+enum WaitMode {
+    WAIT_TRY,                               // give up right away (the item a producer made is dropped)
+    WAIT_BLOCK,                             // block until there is room / an item
+    WAIT_TIMED                              // block, but give up after --wait-ns
+};
+
+//what happens to a producer's items when the buffer is full
+enum OverflowPolicy {
+    OVERFLOW_BLOCK,                         // wait for room, as --producer-wait=block or timed says
+    OVERFLOW_DROP_NEWEST,                   // throw away the items that don't fit
+    OVERFLOW_DROP_OLDEST,                   // remove the oldest items in the buffer to make room
+    OVERFLOW_OVERWRITE                      // write over the oldest items in place, a lossy ring
+};
 
 /**** GLOBAL FLAGS ****/
 char verboseMode = 'n';                              //flag for if verbose mode is turned on
-static bool running = true;                      //flag for the simulation to turn off
-static unsigned int seed = time(nullptr);   //random seed for threads using sleep()
+static atomic<bool> running(true);               //flag for the simulation to turn off (atomic so threads with no think time still see it)
+uint64_t randomSeed = time(nullptr);             //seed every thread's random number generator starts from
+size_t batchSize = 1;                            //how many items a thread moves per action
+buffer_item maxRandomNumber = MAX_RANDOM_NUMBER; //producers generate numbers below this
+bool measureLatency = false;                     //flag for if items are stamped to measure how long they wait in the buffer
+WaitMode producerWait = WAIT_TRY;                //what producers do when the buffer is full
+WaitMode consumerWait = WAIT_TRY;                //what consumers do when the buffer is empty
+OverflowPolicy overflowPolicy = OVERFLOW_DROP_NEWEST; //what producers do with items that don't fit
+long long waitNanoseconds = WAIT_NANOSECONDS;    //how long WAIT_TIMED threads wait before giving up
+WaitStrategy waitStrategy = STRATEGY_ADAPTIVE;   //how blocked threads wait: spinning, yielding and / or parking
+string placementName = "none";                   //how threads were pinned to CPUs, for the final stats
+int laneCount = 1;                               //how many priority lanes producers spread their batches over
 
 /**** GLOBAL VARS ****/
-Buffer buffer = Buffer();                       //buffer used in simulation
-
-int actionsPerformed[MAX_THREADS * 2];          //keeps track of how many times each thread has done its action
-atomic<int> countBufferFull;                    //counter for how many times the buffer is full during simulation
-atomic<int> countBufferEmpty;                   //counter for how many times the buffer is empty during simulation
-
-//keep track of threads in numberProcess()
-sem_t refGeneratorMutex;
-int producer_ID(0);
-int consumer_ID(0);
+BufferBase<buffer_item> *buffer = nullptr;      //buffer used in simulation, picked by --backend in main()
+BufferBase<StampedItem> *stampedBuffer = nullptr; //buffer used instead when --latency stamps items
+LatencyHistogram *latencyHistograms = nullptr;  //how long items waited in the buffer, one histogram per consumer
+AsyncLogger *logger = nullptr;                  //writes verbose output on its own thread with --log=async
+ConsumerScaler *scaler = nullptr;               //parks and wakes consumers with --autoscale
+long long scaleIntervalMs = SCALE_INTERVAL_MS;  //how often the autoscaler samples the buffer
+TraceRecorder *recorder = nullptr;              //writes every insert / remove to a file with --record
+vector<vector<TraceRecord>> replaySchedules;    //the inserts each producer repeats with --replay, in time order
+double replaySpeed = 1.0;                       //how many times faster than recorded a replay runs, 0 for as fast as possible
+long long runStart = 0;                         //nowNanoseconds() time the start gate opened, trace timestamps count from it
+PrimeSieve *primeSieve = nullptr;               //table of which numbers producers can generate are prime
+
+ThreadStats *threadStats = nullptr;             //keeps track of each thread's actions and how often it found the buffer full / empty
+StartGate startGate;                            //holds every thread back until all of them have been created
+vector<Xoshiro256> randomStreams;               //where each thread's random numbers start, one jump() apart
+
+//what each simulation thread is handed when it is created
+struct ThreadParam {
+    const ThinkTime *thinkTime;                 //how long to pause between actions
+    int refId;                                  //the thread's index, producers first, then consumers
+};
+
+//everything the spawners need to create the simulation's threads
+struct ThreadPlan {
+    vector<pthread_t> tid;                      //the threads, producers first
+    vector<char> created;                       //which of them were created
+    vector<int> cpus;                           //the CPU each one is pinned to (-1 for none)
+    void *(*producer)(void *);                  //what producer threads run
+    void *(*consumer)(void *);                  //what consumer threads run
+    int numProducers;
+    bool runProducers;                          //false with --role=consumer
+    bool runConsumers;                          //false with --role=producer
+    size_t stackBytes;                          //0 for the system's default stack size
+    vector<ThreadParam> params;                 //handed to each thread, one per thread
+};
+
+//the share of a ThreadPlan one spawner creates
+struct SpawnJob {
+    ThreadPlan *plan;
+    int first;                                  //index of the first thread to create
+    int last;                                   //one past the last
+};
 
 /**** FUNCTION HEADERS ****/
 //thread functions
-void* producer(void *param);
-void* consumer(void *param);
-int numberProcess(int PROCESS_TYPE);
+template<typename Item> void* producer(void *param);
+template<typename Item> void* consumer(void *param);
+template<typename Item> void* replayProducer(void *param);
+void* spawnThreads(void *param);
+template<typename Item> void* scaleConsumers(void *param);
+template<typename Item> BufferBase<Item>* simulationBuffer();
+template<> BufferBase<buffer_item>* simulationBuffer<buffer_item>();
+template<> BufferBase<StampedItem>* simulationBuffer<StampedItem>();
+template<typename Item> size_t putItems(BufferBase<Item> *BUFFER, const Item *ITEMS, ThreadStats &stats);
+template<typename Item> size_t takeItems(BufferBase<Item> *BUFFER, Item *items, ThreadStats &stats);
+template<typename Item> void traceItems(int REF_ID, TraceOp OP, const Item *ITEMS, size_t COUNT, int SLOT);
+bool parseWaitMode(const string &NAME, WaitMode &result);
+bool parseOverflowPolicy(const string &NAME, OverflowPolicy &result);
+string overflowPolicyName(OverflowPolicy POLICY);
 bool isPrime(buffer_item item);
+size_t countPrimes(const buffer_item *ITEMS, size_t count, bool *results);
+buffer_item randomItem(Xoshiro256 &random);
+int randomLane(Xoshiro256 &random);
+template<typename Item> string describeLanes(BufferBase<Item> *BUFFER);
 //display functions
-void displayBuffer(const string& TITLE, int head, int tail);
-void displayFinalStats (const int &SIMULATION_TIME, const int &MAX_SLEEP_TIME,const int &NUM_PRODUCERS, const int &NUM_CONSUMERS);
+template<typename Item> void displayBuffer(const string& TITLE, int head, int tail);
+void displayFinalStats (const int &SIMULATION_TIME, const int &MAX_SLEEP_TIME,const int &NUM_PRODUCERS, const int &NUM_CONSUMERS, const ThinkTime &THINK_TIME);
 
 
 /*****************************************
@@ -74,31 +161,97 @@ void displayFinalStats (const int &SIMULATION_TIME, const int &MAX_SLEEP_TIME,co
  * **parameters are listed in order they are passed in
  * @param int  Run time
  * @param int  Max sleep time of threads
- * @param int  Number of Producers ( MIN:1  MAX:25 )
- * @param int  Number of Consumers ( MIN:1  MAX:25 )
+ * @param int  Number of Producers ( MIN:1 )
+ * @param int  Number of Consumers ( MIN:1 )
  * @param char 'y' - turns on verbose mode
  *
+ * **optional parameters may follow in any order
+ * @param --backend=semaphore|lockfree|spsc   buffer implementation to run on
+ *                                          (DEFAULT: spsc with 1 producer and 1 consumer, otherwise semaphore)
+ * @param --capacity=int                    number of slots in the buffer (DEFAULT: 5)
+ * @param --batch=int                       items moved per producer / consumer action (DEFAULT: 1)
+ * @param --range=int                       producers generate numbers from 0 up to this (DEFAULT: 100)
+ *                                          (values past INT_MAX need a build with BUFFER_ITEM_64)
+ * @param --seed=int                        seed for the random numbers, to repeat a run (DEFAULT: current time)
+ * @param --think=none|constant|uniform|exponential   how threads pause between actions (DEFAULT: uniform)
+ * @param --think-ns=int                    pause length in nanoseconds: the constant, the uniform maximum,
+ *                                          or the exponential mean (DEFAULT: max sleep time in seconds)
+ * @param --latency=y                       stamp items to measure how long they wait in the buffer (DEFAULT: n)
+ * @param --producer-wait=try|block|timed   what producers do when the buffer is full (DEFAULT: try)
+ * @param --consumer-wait=try|block|timed   what consumers do when the buffer is empty (DEFAULT: try)
+ * @param --overflow=block|drop-newest|drop-oldest|overwrite   what producers do with items that don't fit
+ *                                          (DEFAULT: drop-newest, or block with --producer-wait=block / timed)
+ * @param --wait-ns=int                     how long timed threads wait before giving up (DEFAULT: 1000000)
+ * @param --wait-policy=spin|yield|park|adaptive   how blocked threads wait (DEFAULT: adaptive)
+ * @param --shards=int                      split the buffer into this many shards, consumers steal
+ *                                          between them (DEFAULT: 1, needs semaphore or lockfree)
+ * @param --lanes=int                       give the buffer this many priority lanes of --capacity slots
+ *                                          each, consumers drain higher lanes first (DEFAULT: 1, MAX: 8)
+ * @param --lane-credit=int                 removes a waiting lane lets higher lanes take before it is
+ *                                          served anyway (DEFAULT: 8)
+ * @param --placement=none|compact|scatter|pairs   how threads are pinned to CPUs (DEFAULT: none)
+ * @param --cpus=list                       pin threads round robin to these CPUs, like 0-3,8 (overrides --placement)
+ * @param --log=sync|async                  with verbose mode, print from each thread or hand output
+ *                                          to a writer thread (DEFAULT: sync)
+ * @param --shm=name                        put the buffer in shared memory under this name, other
+ *                                          processes using the same name share it (overrides --backend)
+ * @param --role=both|producer|consumer     with --shm, which threads this process runs (DEFAULT: both)
+ * @param --stack-kb=int                    stack size of each producer / consumer in KiB, 0 for the system
+ *                                          default (DEFAULT: 256)
+ * @param --autoscale=int                   start this many consumers working and add or park consumers,
+ *                                          up to the number of consumers, as the buffer fills and drains
+ * @param --autoscale-ms=int                how often the autoscaler samples the buffer (DEFAULT: 100)
+ * @param --record=file                     write every insert and remove to a binary trace file
+ * @param --replay=file                     producers repeat the inserts recorded in a trace file instead
+ *                                          of generating random numbers
+ * @param --replay-speed=max|number         how many times faster than recorded to replay (DEFAULT: 1)
+ *
  * @return       0        successful simulation
  * @return      -1        Invalid Arguments: incorrect number of arguments
  * @return       1        Invalid Arguments: incorrect type / 0 for an argument
- * @return       2        Invalid Arguments: too many threads
+ * @return       2        the system could not create every thread
  *
  *****************************************/
 int main(int argc, char* argv[]) {
 
-    sem_init(&refGeneratorMutex, 0, 1); //initiate mutex to number processes
-
-
     ///VALIDATE AND SET USER ARGUMENTS
     string invalidArgMsg = "INVALID ARGUMENTS!!\n"
                             "The format of parameters are as followed:\n"
                                "\tint Run time\n"
                                 "\tint Max sleep time of threads\n"
-                                "\tint Number of Producers  ( MIN:1  MAX:25 )\n"
-                                "\tint Number of Consumers  ( MIN:1  MAX:25 )\n"
-                                "\tchar 'y' - Verbose mode\n\n";
-
-    if (argc != 6) {
+                                "\tint Number of Producers  ( MIN:1 )\n"
+                                "\tint Number of Consumers  ( MIN:1 )\n"
+                                "\tchar 'y' - Verbose mode\n"
+                            "Optional parameters:\n"
+                                "\t--backend=semaphore|lockfree|spsc  Buffer implementation (spsc needs 1 producer and 1 consumer)\n"
+                                "\t--capacity=int  Number of slots in the buffer (DEFAULT: 5)\n"
+                                "\t--batch=int  Items moved per producer / consumer action (DEFAULT: 1)\n"
+                                "\t--range=int  Producers generate numbers from 0 up to this (DEFAULT: 100)\n"
+                                "\t--seed=int  Seed for the random numbers, to repeat a run (DEFAULT: current time)\n"
+                                "\t--think=none|constant|uniform|exponential  How threads pause between actions (DEFAULT: uniform)\n"
+                                "\t--think-ns=int  Pause length in nanoseconds (DEFAULT: max sleep time in seconds)\n"
+                                "\t--latency=y  Measure how long items wait in the buffer (DEFAULT: n)\n"
+                                "\t--producer-wait=try|block|timed  What producers do when the buffer is full (DEFAULT: try)\n"
+                                "\t--consumer-wait=try|block|timed  What consumers do when the buffer is empty (DEFAULT: try)\n"
+                                "\t--overflow=block|drop-newest|drop-oldest|overwrite  What producers do with items that don't fit (DEFAULT: drop-newest)\n"
+                                "\t--wait-ns=int  How long timed threads wait before giving up (DEFAULT: 1000000)\n"
+                                "\t--wait-policy=spin|yield|park|adaptive  How blocked threads wait (DEFAULT: adaptive)\n"
+                                "\t--shards=int  Split the buffer into this many shards (DEFAULT: 1, needs semaphore or lockfree)\n"
+                                "\t--lanes=int  Priority lanes consumers drain highest first (DEFAULT: 1, MAX: 8)\n"
+                                "\t--lane-credit=int  Removes a waiting lane lets higher lanes take before it is served (DEFAULT: 8)\n"
+                                "\t--placement=none|compact|scatter|pairs  How threads are pinned to CPUs (DEFAULT: none)\n"
+                                "\t--cpus=list  Pin threads round robin to these CPUs, like 0-3,8 (overrides --placement)\n"
+                                "\t--log=sync|async  Verbose output printed by each thread or by a writer thread (DEFAULT: sync)\n"
+                                "\t--shm=name  Put the buffer in shared memory that other processes can attach to by name\n"
+                                "\t--role=both|producer|consumer  With --shm, which threads this process runs (DEFAULT: both)\n"
+                                "\t--stack-kb=int  Stack size of each thread in KiB, 0 for the system default (DEFAULT: 256)\n"
+                                "\t--autoscale=int  Fewest consumers kept working, more are woken as the buffer fills\n"
+                                "\t--autoscale-ms=int  How often the autoscaler samples the buffer (DEFAULT: 100)\n"
+                                "\t--record=file  Write every insert and remove to a binary trace file\n"
+                                "\t--replay=file  Producers repeat the inserts recorded in a trace file\n"
+                                "\t--replay-speed=max|number  How many times faster than recorded to replay (DEFAULT: 1)\n\n";
+
+    if (argc < 6) {
         printf("%s", invalidArgMsg.c_str());
         return -1;
     } //end if
@@ -110,60 +263,355 @@ int main(int argc, char* argv[]) {
     const int NUM_CONSUMERS = atoi(argv[4]);
     verboseMode = *argv[5];
 
-    consumer_ID = NUM_PRODUCERS; //consumer actions are saved in memory spaces allocated after producer actions
+    if (MAX_RUN_TIME == 0 || MAX_SLEEP_TIME == 0 || NUM_PRODUCERS == 0 || NUM_CONSUMERS == 0) { // if any param is invalid or set to 0 return 1
+        printf("%s", invalidArgMsg.c_str());
+        return 1;
+    } //end if
 
+    if (NUM_PRODUCERS < 0 || NUM_CONSUMERS < 0) { // thread counts are only limited by the system, but can't be negative
+        printf("%s", invalidArgMsg.c_str());
+        return 1;
+    } //end if
 
+    //optional arguments
+    string backend;
+    int capacity = BUFFER_SIZE;
+    int batch = 1;
+    int shards = 1;
+    long long laneCredit = PRIORITY_LANE_CREDIT;
+    ThreadPlacement placement = PLACE_NONE;
+    vector<int> cpuList;
+    string logMode = "sync";
+    string recordPath;
+    string shmName;
+    string role = "both";
+    long long stackKilobytes = THREAD_STACK_KB;
+    int minConsumers = 0; //0 keeps every consumer working
+    bool overflowGiven = false;
+    string replayPath;
+    ThinkDistribution thinkDistribution = THINK_UNIFORM;
+    long long thinkNanoseconds = MAX_SLEEP_TIME * NANOSECONDS_PER_SECOND;
+    for (int i = 6; i < argc; i++) {
+        const char *value;
+        if ((value = optionValue(argv[i], "--backend")) != nullptr) {
+            backend = value;
+        } else if ((value = optionValue(argv[i], "--capacity")) != nullptr) {
+            capacity = atoi(value);
+        } else if ((value = optionValue(argv[i], "--batch")) != nullptr) {
+            batch = atoi(value);
+        } else if ((value = optionValue(argv[i], "--range")) != nullptr) {
+            maxRandomNumber = (buffer_item)strtoull(value, nullptr, 10);
+        } else if ((value = optionValue(argv[i], "--seed")) != nullptr) {
+            randomSeed = strtoull(value, nullptr, 10);
+        } else if ((value = optionValue(argv[i], "--think")) != nullptr) {
+            if (!ThinkTime::parseDistribution(value, thinkDistribution)) { // unknown distribution
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else if ((value = optionValue(argv[i], "--think-ns")) != nullptr) {
+            thinkNanoseconds = atoll(value);
+        } else if ((value = optionValue(argv[i], "--latency")) != nullptr) {
+            measureLatency = *value == 'y';
+        } else if ((value = optionValue(argv[i], "--producer-wait")) != nullptr) {
+            if (!parseWaitMode(value, producerWait)) { // unknown mode
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else if ((value = optionValue(argv[i], "--consumer-wait")) != nullptr) {
+            if (!parseWaitMode(value, consumerWait)) { // unknown mode
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else if ((value = optionValue(argv[i], "--wait-ns")) != nullptr) {
+            waitNanoseconds = atoll(value);
+        } else if ((value = optionValue(argv[i], "--shards")) != nullptr) {
+            shards = atoi(value);
+        } else if ((value = optionValue(argv[i], "--lanes")) != nullptr) {
+            laneCount = atoi(value);
+        } else if ((value = optionValue(argv[i], "--lane-credit")) != nullptr) {
+            laneCredit = atoll(value);
+        } else if ((value = optionValue(argv[i], "--placement")) != nullptr) {
+            if (!parsePlacement(value, placement)) { // unknown placement
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+            placementName = value;
+        } else if ((value = optionValue(argv[i], "--cpus")) != nullptr) {
+            cpuList = splitRanges(value);
+            placement = PLACE_LIST;
+            placementName = value;
+        } else if ((value = optionValue(argv[i], "--log")) != nullptr) {
+            logMode = value;
+        } else if ((value = optionValue(argv[i], "--shm")) != nullptr) {
+            shmName = value;
+        } else if ((value = optionValue(argv[i], "--role")) != nullptr) {
+            role = value;
+        } else if ((value = optionValue(argv[i], "--stack-kb")) != nullptr) {
+            stackKilobytes = atoll(value);
+        } else if ((value = optionValue(argv[i], "--overflow")) != nullptr) {
+            if (!parseOverflowPolicy(value, overflowPolicy)) { // unknown policy
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+            overflowGiven = true;
+        } else if ((value = optionValue(argv[i], "--autoscale")) != nullptr) {
+            minConsumers = atoi(value);
+            if (minConsumers < 1 || minConsumers > NUM_CONSUMERS) { // has to leave the pool room to grow into
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else if ((value = optionValue(argv[i], "--autoscale-ms")) != nullptr) {
+            scaleIntervalMs = atoll(value);
+            if (scaleIntervalMs <= 0) {
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else if ((value = optionValue(argv[i], "--record")) != nullptr) {
+            recordPath = value;
+        } else if ((value = optionValue(argv[i], "--replay")) != nullptr) {
+            replayPath = value;
+        } else if ((value = optionValue(argv[i], "--replay-speed")) != nullptr) {
+            replaySpeed = strcmp(value, "max") == 0 ? 0 : atof(value);
+            if (replaySpeed <= 0 && strcmp(value, "max") != 0) { // not a speed
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else if ((value = optionValue(argv[i], "--wait-policy")) != nullptr) {
+            if (!WaitPolicy::parseStrategy(value, waitStrategy)) { // unknown strategy
+                printf("%s", invalidArgMsg.c_str());
+                return 1;
+            } //end if
+        } else { // unknown option
+            printf("%s", invalidArgMsg.c_str());
+            return 1;
+        } //end else
+    } //end for
 
-    if (MAX_RUN_TIME == 0 || MAX_SLEEP_TIME == 0 || NUM_PRODUCERS == 0 || NUM_CONSUMERS == 0) { // if any param is invalid or set to 0 return 1
+    if (capacity <= 0 || batch <= 0 || shards <= 0 || maxRandomNumber < 1 || (logMode != "sync" && logMode != "async")
+        || (role != "both" && role != "producer" && role != "consumer") || (role != "both" && shmName.empty())
+        || (!shmName.empty() && shards > 1) || stackKilobytes < 0 || laneCount < 1 || laneCount > PRIORITY_MAX_LANES
+        || (laneCount > 1 && (shards > 1 || !shmName.empty())) || laneCredit < 1) { // a buffer needs at least one slot, threads need to move at least one item, and a range needs a number in it
         printf("%s", invalidArgMsg.c_str());
         return 1;
     } //end if
+    batchSize = batch;
+
+    //--overflow and --producer-wait describe the same choice, the policy wins when both are given
+    if (!overflowGiven)
+        overflowPolicy = producerWait == WAIT_TRY ? OVERFLOW_DROP_NEWEST : OVERFLOW_BLOCK;
+    else if (overflowPolicy == OVERFLOW_BLOCK && producerWait == WAIT_TRY)
+        producerWait = WAIT_BLOCK;
+    else if (overflowPolicy == OVERFLOW_DROP_NEWEST)
+        producerWait = WAIT_TRY;
+
+    //producers that push the oldest items out remove them too, which the single consumer spsc buffer can't allow
+    const bool LOSSY = overflowPolicy == OVERFLOW_DROP_OLDEST || overflowPolicy == OVERFLOW_OVERWRITE;
+    if (backend.empty()) {
+        backend = LOSSY ? "semaphore" : defaultBackend(NUM_PRODUCERS, NUM_CONSUMERS);
+    } else if (LOSSY && backend == "spsc") {
+        printf("%s", invalidArgMsg.c_str());
+        return 1;
+    } //end else
+
+    //load the producer traffic to repeat, recorded producer i is replayed by producer i % NUM_PRODUCERS
+    if (!replayPath.empty()) {
+        vector<vector<TraceRecord>> recorded;
+        if (!loadProducerSchedules(replayPath, recorded)) { // missing file, or not a trace
+            printf("%s", invalidArgMsg.c_str());
+            return 1;
+        } //end if
+        replaySchedules.resize(NUM_PRODUCERS);
+        for (size_t i = 0; i < recorded.size(); i++) {
+            vector<TraceRecord> &schedule = replaySchedules[i % NUM_PRODUCERS];
+            const size_t MIDDLE = schedule.size();
+            schedule.insert(schedule.end(), recorded[i].begin(), recorded[i].end());
+            inplace_merge(schedule.begin(), schedule.begin() + MIDDLE, schedule.end(), []( const TraceRecord &A, const TraceRecord &B ) {
+                return A.timestamp < B.timestamp;
+            });
+            for (const TraceRecord &RECORD : recorded[i]) { //the sieve has to cover every number replayed
+                if ((buffer_item)RECORD.value >= maxRandomNumber)
+                    maxRandomNumber = (buffer_item)RECORD.value + 1;
+            } //end for
+        } //end for
+    } //end if
 
-    if (NUM_PRODUCERS > MAX_THREADS || NUM_CONSUMERS > MAX_THREADS) { // if the user asks for more threads than the program can create return 2
+    //find which CPUs each thread runs on
+    const CpuTopology TOPOLOGY = CpuTopology::discover();
+    if (placement == PLACE_LIST) {
+        bool usable = !cpuList.empty();
+        for (const int CPU : cpuList) {
+            usable = usable && TOPOLOGY.contains(CPU);
+        } //end for
+        if (!usable) { // an empty list, or a CPU the process can't run on
+            printf("%s", invalidArgMsg.c_str());
+            return 1;
+        } //end if
+    } //end if
+    const vector<int> THREAD_CPUS = placeThreads(placement, TOPOLOGY, NUM_PRODUCERS, NUM_CONSUMERS, cpuList);
+    if (placement != PLACE_NONE)
+        placementName += " (" + TOPOLOGY.describe() + ")";
+    const ThinkTime THINK_TIME(thinkDistribution, thinkNanoseconds);
+
+    ///CREATE BUFFER FOR SIMULATION
+    //with --shm the buffer is shared with other processes instead of built by --backend
+    if (measureLatency) {
+        if (shmName.empty())
+            stampedBuffer = makeBuffer<StampedItem>(backend, capacity, NUM_PRODUCERS, NUM_CONSUMERS, shards, laneCount, laneCredit);
+        else
+            stampedBuffer = makeSharedBuffer<StampedItem>(shmName, capacity);
+        latencyHistograms = new LatencyHistogram[NUM_PRODUCERS + NUM_CONSUMERS];
+    } else {
+        if (shmName.empty())
+            buffer = makeBuffer<buffer_item>(backend, capacity, NUM_PRODUCERS, NUM_CONSUMERS, shards, laneCount, laneCredit);
+        else
+            buffer = makeSharedBuffer<buffer_item>(shmName, capacity);
+    } //end else
+    if (buffer == nullptr && stampedBuffer == nullptr) { // unknown backend, spsc with more than one producer / consumer, or a shared segment that won't open
         printf("%s", invalidArgMsg.c_str());
-        return 2;
+        return 1;
     } //end if
+    if (measureLatency)
+        stampedBuffer->setWaitStrategy(waitStrategy);
+    else
+        buffer->setWaitStrategy(waitStrategy);
+
+    ///CHECK WHICH NUMBERS ARE PRIME BEFORE ANY CONSUMER NEEDS TO KNOW
+    primeSieve = new PrimeSieve(maxRandomNumber);
 
 
     ///CREATE THREADS FOR SIMULATION
     //init threads
-    pthread_t tid[MAX_THREADS];
-    pthread_attr_t attr;
-    pthread_attr_init(&attr);
+    const int TOTAL_THREADS = NUM_PRODUCERS + NUM_CONSUMERS;
+    threadStats = new ThreadStats[TOTAL_THREADS];
+    Xoshiro256 stream(randomSeed); //jumping once per thread here, rather than REF_ID times in each thread
+    randomStreams.reserve(TOTAL_THREADS);
+    for (int i = 0; i < TOTAL_THREADS; i++) {
+        randomStreams.push_back(stream);
+        stream.jump();
+    } //end for
+    ThreadPlan plan;
+    plan.tid.resize(TOTAL_THREADS);
+    plan.created.assign(TOTAL_THREADS, false);
+    plan.cpus = THREAD_CPUS;
+    plan.numProducers = NUM_PRODUCERS;
+    plan.stackBytes = (size_t)stackKilobytes * 1024;
+    if (plan.stackBytes > 0 && plan.stackBytes < (size_t)PTHREAD_STACK_MIN) // the smallest stack a thread can have
+        plan.stackBytes = PTHREAD_STACK_MIN;
+    plan.params.resize(TOTAL_THREADS);
+    for (int i = 0; i < TOTAL_THREADS; i++) {
+        plan.params[i] = {&THINK_TIME, i}; //consumer actions are saved in memory spaces allocated after producer actions
+    } //end for
 
     //create and assign threads
     cout<<"Starting threads..."<<endl;
 
     if (verboseMode == 'y') { //display initial conditions
-        displayBuffer("",buffer.head, buffer.tail);
+        if (measureLatency)
+            displayBuffer<StampedItem>("",stampedBuffer->getHead(), stampedBuffer->getTail());
+        else
+            displayBuffer<buffer_item>("",buffer->getHead(), buffer->getTail());
     } //end if
 
-    //creates producer threads
-    for (int i = 0; i < NUM_PRODUCERS; i++) {
-        pthread_create(&tid[i], &attr, producer, (void*)argv[2]);
+    if (verboseMode == 'y' && logMode == "async") { //threads record their actions for the writer thread instead of printing
+        logger = new AsyncLogger(NUM_PRODUCERS + NUM_CONSUMERS);
+        logger->start();
+    } //end if
+
+    if (!recordPath.empty()) { //threads write their actions to the trace file
+        recorder = new TraceRecorder(recordPath, NUM_PRODUCERS + NUM_CONSUMERS);
+        if (!recorder->isOpen())
+            printf("Could not open %s, the run will not be recorded\n\n", recordPath.c_str());
+    } //end if
+
+    //threads move stamped items only when latency is being measured, producers repeat a trace with --replay
+    plan.producer = measureLatency ? producer<StampedItem> : producer<buffer_item>;
+    if (!replayPath.empty())
+        plan.producer = measureLatency ? replayProducer<StampedItem> : replayProducer<buffer_item>;
+    plan.consumer = measureLatency ? consumer<StampedItem> : consumer<buffer_item>;
+
+    //with --role, this process only runs one side and another process attached to --shm runs the other
+    plan.runProducers = role != "consumer";
+    plan.runConsumers = role != "producer";
+    if (minConsumers > 0 && plan.runConsumers) //consumers past the first minConsumers start parked
+        scaler = new ConsumerScaler(NUM_PRODUCERS, minConsumers, NUM_CONSUMERS);
+
+    //creates producer and consumer threads, split across spawner threads when there are many of them
+    const int SPAWNERS = max(1, min((TOTAL_THREADS + THREADS_PER_SPAWNER - 1) / THREADS_PER_SPAWNER, (int)TOPOLOGY.size()));
+    vector<SpawnJob> spawnJobs(SPAWNERS);
+    vector<pthread_t> spawners(SPAWNERS);
+    vector<char> spawnerStarted(SPAWNERS, false);
+    for (int i = 0; i < SPAWNERS; i++) {
+        spawnJobs[i] = {&plan, (int)((long long)TOTAL_THREADS * i / SPAWNERS), (int)((long long)TOTAL_THREADS * (i + 1) / SPAWNERS)};
+        if (i > 0) // main() is the first spawner
+            spawnerStarted[i] = pthread_create(&spawners[i], nullptr, spawnThreads, &spawnJobs[i]) == 0;
+    } //end for
+    spawnThreads(&spawnJobs[0]);
+    for (int i = 1; i < SPAWNERS; i++) {
+        if (spawnerStarted[i])
+            pthread_join(spawners[i], nullptr);
+        else
+            spawnThreads(&spawnJobs[i]); //no spawner to spare, create its share here
     } //end for
 
-    //creates consumer threads
-    for (int i = 0; i < NUM_CONSUMERS; i++) {
-        pthread_create(&tid[i+NUM_PRODUCERS], &attr, consumer, (void*)argv[2]);
+    int missingThreads = 0;
+    for (int i = 0; i < TOTAL_THREADS; i++) {
+        if (!plan.created[i] && (i < NUM_PRODUCERS ? plan.runProducers : plan.runConsumers))
+            missingThreads++;
     } //end for
 
+    //every thread is waiting at the start gate, let them go together
+    runStart = nowNanoseconds();
+    if (recorder != nullptr) //recorded and replayed timestamps both count from the gate opening
+        recorder->start(runStart);
+    if (missingThreads > 0) { //the system ran out of threads, stop the ones that were made
+        printf("Could not create %d of %d threads, try fewer threads or a smaller --stack-kb\n", missingThreads, TOTAL_THREADS);
+        running = false;
+    } //end if
+    startGate.open();
+
+    //the autoscaler watches the buffer while the simulation runs
+    pthread_t controller;
+    const bool SCALING = scaler != nullptr
+        && pthread_create(&controller, nullptr, measureLatency ? scaleConsumers<StampedItem> : scaleConsumers<buffer_item>, nullptr) == 0;
 
-    sleep(MAX_RUN_TIME);
+    if (missingThreads == 0)
+        sleep(MAX_RUN_TIME);
     //wait sim time...
     //...
     //...
     running = false; //signal threads simulation is done
+    if (measureLatency) //wake threads blocked on the buffer
+        stampedBuffer->close();
+    else
+        buffer->close();
+    if (scaler != nullptr) //wake parked consumers
+        scaler->stop();
+    if (SCALING)
+        pthread_join(controller, nullptr);
 
     //rejoin all threads
-    int totalThreads = NUM_PRODUCERS + NUM_CONSUMERS;
-    for (int i = 0; i < totalThreads; i++) {
-        pthread_join(tid[i], nullptr);
+    for (int i = 0; i < TOTAL_THREADS; i++) {
+        if (plan.created[i])
+            pthread_join(plan.tid[i], nullptr);
     } //end for
 
-    displayFinalStats(MAX_RUN_TIME, MAX_SLEEP_TIME , NUM_PRODUCERS, NUM_CONSUMERS);
-
-    return 0;
+    if (logger != nullptr) //write out the last of the verbose output
+        logger->stop();
+    if (recorder != nullptr) //write out the last of the trace
+        recorder->finish();
+
+    if (missingThreads == 0)
+        displayFinalStats(MAX_RUN_TIME, MAX_SLEEP_TIME , NUM_PRODUCERS, NUM_CONSUMERS, THINK_TIME);
+
+    delete buffer;
+    delete stampedBuffer;
+    delete[] latencyHistograms;
+    delete logger;
+    delete recorder;
+    delete scaler;
+    delete primeSieve;
+    delete[] threadStats;
+    return missingThreads > 0 ? 2 : 0;
 } //end main
 
 /*****************************************
@@ -179,65 +627,119 @@ int main(int argc, char* argv[]) {
 * A producer will keep track of every time it completes an action
 * as well as how many times the buffer is full when it trys to access
 * it.
+* With --batch set, each action generates and inserts that many
+* items at once. If only part of a batch fits, the rest are dropped.
+* Item is buffer_item, or StampedItem when --latency is on, in which
+* case every item is stamped with the time it is inserted.
+* With --producer-wait=block or timed, a full buffer makes the
+* producer wait for room instead of dropping the items.
+* With --lanes, every batch is tagged with a random lane, and only
+* waits on / is dropped by that lane being full.
 *
-* @param param    maximum amount of time the thread will sleep for
+* @param param    the ThreadParam with the thread's index and the ThinkTime it pauses by
 *
 * @return 0       when signal simulation ends
 *****************************************/
+template<typename Item>
 void* producer(void *param) {
 
 
-    //creates variable for max sleeping time from user argument
-    int sleepTime;
-    const char * argv = static_cast<char *>(param);
-    int maxSleepTime = atoi(argv);
+    //how long to pause between actions
+    const ThreadParam &PARAM = *static_cast<const ThreadParam *>(param);
+    const ThinkTime &THINK_TIME = *PARAM.thinkTime;
+    const bool THINKS = !THINK_TIME.isNone();
+    long long sleepStart;
 
     //identify thread
     const int PROCESS_ID = getpid();
-    const int REF_ID = numberProcess(PRODUCER_TAG);
+    const int REF_ID = PARAM.refId;
+    ThreadStats &stats = threadStats[REF_ID];
+    startGate.wait(); //until every thread has been created
+    Xoshiro256 random = randomStreams[REF_ID]; //this thread's own stream of random numbers
+
+    BufferBase<Item> *const BUFFER = simulationBuffer<Item>()->forThread(REF_ID); //the thread's home shard with --shards
+    vector<Item> producedItems(batchSize);         //random numbers to be put in buffer
+    size_t inserted;                               //how many of them fit
+    BufferBase<Item> *laneBuffer;                  //the priority lane the batch goes into with --lanes
 
     if (verboseMode == 'y') { //it is meaningless to check if verbose is on every time a thread does its action, so it will only check once
 
         string outputHeader; // describes the threads action for output
 
         while (running) { //until signalled to stop by main()
-            //generates sleep time and waits
-            sleepTime = rand_r(&seed) % maxSleepTime;
-            sleep(sleepTime);
+            //generates think time and waits
+            if (THINKS) {
+                sleepStart = nowNanoseconds();
+                THINK_TIME.wait(random);
+                stats.waitNanoseconds.add(nowNanoseconds() - sleepStart);
+            } //end if
 
-            //when wakes up, attempts to put a number into the buffer
-            buffer_item producedItem = rand() % MAX_RANDOM_NUMBER; //random number to be put in buffer
+            //when wakes up, attempts to put a batch of numbers into the buffer
+            for (size_t i = 0; i < batchSize; i++) {
+                setItemValue(producedItems[i], randomItem(random));
+            } //end for
+            stampItems(producedItems.data(), batchSize);
 
-            if (!buffer.buffer_insert_item(producedItem)) { //buffer full
-                countBufferFull++;
-                printf("All buffers full. Producer %d waits.\n\n", PROCESS_ID);
+            laneBuffer = laneCount > 1 ? BUFFER->forLane(randomLane(random)) : BUFFER;
+            inserted = putItems(laneBuffer, producedItems.data(), stats);
+
+            if (inserted == 0) { //buffer full
+                stats.bufferFull.add(1);
+                if (logger != nullptr)
+                    logger->log(REF_ID, LOG_FULL, 0, false, BUFFER);
+                else
+                    printf("All buffers full. Producer %d waits.\n\n", PROCESS_ID);
                 continue; //unsuccessful
             } //end if
+            if (inserted < batchSize) { //buffer filled up partway through the batch
+                stats.bufferFull.add(1);
+            } //end if
 
-            //successful in putting an item in the buffer
-            outputHeader = "Producer " + to_string(PROCESS_ID) + " writes " + to_string(producedItem);
-            actionsPerformed[REF_ID]++;
-            displayBuffer(outputHeader,buffer.head, buffer.tail);
+            //successful in putting items in the buffer
+            stats.actions.add((long long)inserted);
+            traceItems(REF_ID, TRACE_INSERT, producedItems.data(), inserted, laneBuffer->getTail());
+            if (logger != nullptr) { //hand the action to the writer thread
+                for (size_t i = 0; i < inserted; i++) {
+                    logger->log(REF_ID, LOG_INSERT, itemValue(producedItems[i]), false, BUFFER);
+                } //end for
+                continue;
+            } //end if
+            outputHeader = "Producer " + to_string(PROCESS_ID) + " writes";
+            for (size_t i = 0; i < inserted; i++) {
+                outputHeader += " " + to_string(itemValue(producedItems[i]));
+            } //end for
+            displayBuffer<Item>(outputHeader,BUFFER->getHead(), BUFFER->getTail());
         } //end while
     } //end if
 
     else { //verbose mode off - identical, but removes printf statements and related calls
 
         while (running) { //until signalled to stop by main()
-            //generates sleep time and waits
-            sleepTime = rand_r(&seed) % maxSleepTime;
-            sleep(sleepTime);
+            //generates think time and waits
+            if (THINKS) {
+                sleepStart = nowNanoseconds();
+                THINK_TIME.wait(random);
+                stats.waitNanoseconds.add(nowNanoseconds() - sleepStart);
+            } //end if
 
-            //when wakes up, attempts to put a number into the buffer
-            buffer_item producedItem = rand() % 100; //random number to be put in buffer
+            //when wakes up, attempts to put a batch of numbers into the buffer
+            for (size_t i = 0; i < batchSize; i++) {
+                setItemValue(producedItems[i], randomItem(random));
+            } //end for
+            stampItems(producedItems.data(), batchSize);
 
-            if (!buffer.buffer_insert_item(producedItem)) { //buffer full
-                countBufferFull++;
-                continue; //unsuccessful
+            laneBuffer = laneCount > 1 ? BUFFER->forLane(randomLane(random)) : BUFFER;
+            inserted = putItems(laneBuffer, producedItems.data(), stats);
+
+            if (inserted < batchSize) { //buffer full
+                stats.bufferFull.add(1);
+                if (inserted == 0)
+                    continue; //unsuccessful
             } //end if
 
-            //successful in putting an item in the buffer
-            actionsPerformed[REF_ID]++;
+            //successful in putting items in the buffer
+            stats.actions.add((long long)inserted);
+            traceItems(REF_ID, TRACE_INSERT, producedItems.data(), inserted, laneBuffer->getTail());
         } //end while
     } //end else
     pthread_exit(nullptr);
@@ -252,111 +754,437 @@ void* producer(void *param) {
 * When initiated, a thread will identify itself and begin to
 * take items from the buffer. If the buffer is empty, the thread
 * will output it was unsuccessful, if verbose mode is turned off.
-* If verbose mode is turned on, it will also alert the user if
-* the item the consumer pulled is a prime number.
+* Every item pulled is checked for being prime, and if verbose
+* mode is turned on, it will also alert the user if the item the
+* consumer pulled is a prime number.
 * A consumer will keep track of every time it completes an action
 * as well as how many times the buffer is empty when it trys to access
 * it.
+* With --batch set, each action takes up to that many items at once.
+* With --latency on, every item pulled also records how long it sat
+* in the buffer in the consumer's own histogram.
+* With --consumer-wait=block or timed, an empty buffer makes the
+* consumer wait for an item instead of going back to sleep.
+* With --autoscale, a consumer the autoscaler doesn't need sleeps
+* until it is woken again, without thinking or touching the buffer.
 *
-* @param param  maximum amount of time the thread will sleep for
+* @param param  the ThreadParam with the thread's index and the ThinkTime it pauses by
 *
 * @return 0     when signal simulation ends
 *****************************************/
+template<typename Item>
 void *consumer(void *param) {
 
-    //creates variable for max sleeping time from user argument
-    int sleepTime;
-    const char * argv = static_cast<char *>(param);
-    int maxSleepTime = atoi(argv);
+    //how long to pause between actions
+    const ThreadParam &PARAM = *static_cast<const ThreadParam *>(param);
+    const ThinkTime &THINK_TIME = *PARAM.thinkTime;
+    const bool THINKS = !THINK_TIME.isNone();
+    long long sleepStart;
 
     //identify thread
     const int PROCESS_ID = getpid();
-    const int REF_ID = numberProcess(CONSUMER_TAG);
-
-    buffer_item consumedItem; //item the consumer pulls from the buffer
+    const int REF_ID = PARAM.refId;
+    ThreadStats &stats = threadStats[REF_ID];
+    startGate.wait(); //until every thread has been created
+    Xoshiro256 random = randomStreams[REF_ID]; //this thread's own stream of random numbers
+
+    BufferBase<Item> *const BUFFER = simulationBuffer<Item>()->forThread(REF_ID); //the thread's home shard with --shards
+    LatencyHistogram *const LATENCIES = measureLatency ? &latencyHistograms[REF_ID] : nullptr;
+    vector<Item> consumedItems(batchSize);         //items the consumer pulls from the buffer
+    vector<buffer_item> itemScratch(batchSize);    //numbers carried by stamped items
+    const buffer_item *values;                     //numbers carried by the items pulled
+    unique_ptr<bool[]> primeItems(new bool[batchSize]); //which of those items are prime
+    size_t removed;                                //how many items were pulled
 
     if (verboseMode == 'y') { //it is meaningless to check if verbose is on every time a thread does its action, so it will only check once
 
         string outputHeader; // describes the threads action for output
 
         while (running) { //until signalled to stop by main()
-            //generates sleep time and waits
-            sleepTime = rand_r(&seed) % maxSleepTime;
-            sleep(sleepTime);
-
+            if (scaler != nullptr && !scaler->isActive(REF_ID)) { //not needed right now
+                scaler->park(REF_ID);
+                continue;
+            } //end if
+            //generates think time and waits
+            if (THINKS) {
+                sleepStart = nowNanoseconds();
+                THINK_TIME.wait(random);
+                stats.waitNanoseconds.add(nowNanoseconds() - sleepStart);
+            } //end if
 
-            if (!buffer.buffer_remove_item(&consumedItem)) { //buffer is empty
-                countBufferEmpty++;
-                printf("All buffers empty. Consumer %d waits.\n\n", PROCESS_ID);
-                continue; //unsuccessful
+            removed = takeItems(BUFFER, consumedItems.data(), stats);
 
-            } else { //consumer pulled item from buffer
-                //calculate if number is prime
-                if (isPrime(consumedItem))
-                    outputHeader = "Consumer " + to_string(PROCESS_ID) + " reads " + to_string(consumedItem) + "\t*****PRIME NUMBER*****";
+            if (removed == 0) { //buffer is empty
+                stats.bufferEmpty.add(1);
+                if (logger != nullptr)
+                    logger->log(REF_ID, LOG_EMPTY, 0, false, BUFFER);
                 else
-                    outputHeader = "Consumer " + to_string(PROCESS_ID) + " reads " + to_string(consumedItem);
+                    printf("All buffers empty. Consumer %d waits.\n\n", PROCESS_ID);
+                continue; //unsuccessful
 
-                //successful in removing an item from the buffer
-                actionsPerformed[REF_ID]++;
+            } else { //consumer pulled items from buffer
+                recordLatencies(consumedItems.data(), removed, LATENCIES);
+                //calculate if each number is prime
+                values = itemValues(consumedItems.data(), removed, itemScratch);
+                stats.primes.add((long long)countPrimes(values, removed, primeItems.get()));
+
+                //successful in removing items from the buffer
+                stats.actions.add((long long)removed);
+                traceItems(REF_ID, TRACE_REMOVE, values, removed, BUFFER->getHead());
+                if (logger != nullptr) { //hand the action to the writer thread
+                    for (size_t i = 0; i < removed; i++) {
+                        logger->log(REF_ID, LOG_REMOVE, values[i], primeItems[i], BUFFER);
+                    } //end for
+                    continue;
+                } //end if
+
+                outputHeader = "Consumer " + to_string(PROCESS_ID) + " reads";
+                for (size_t i = 0; i < removed; i++) {
+                    outputHeader += " " + to_string(values[i]);
+                    if (primeItems[i])
+                        outputHeader += removed == 1 ? "\t*****PRIME NUMBER*****" : "(PRIME)";
+                } //end for
             } //end else
 
-            displayBuffer(outputHeader,buffer.head, buffer.tail);
+            displayBuffer<Item>(outputHeader,BUFFER->getHead(), BUFFER->getTail());
 
         } //end while
 
     } else { //verbose mode off - identical, but removes printf statements and related calls
         while (running) { //until signalled to stop by main()
-            //generates sleep time and waits
-            sleepTime = rand_r(&seed) % maxSleepTime;
-            sleep(sleepTime);
+            if (scaler != nullptr && !scaler->isActive(REF_ID)) { //not needed right now
+                scaler->park(REF_ID);
+                continue;
+            } //end if
+            //generates think time and waits
+            if (THINKS) {
+                sleepStart = nowNanoseconds();
+                THINK_TIME.wait(random);
+                stats.waitNanoseconds.add(nowNanoseconds() - sleepStart);
+            } //end if
+
+            removed = takeItems(BUFFER, consumedItems.data(), stats);
 
-            if (!buffer.buffer_remove_item(&consumedItem)) { //buffer full
-                countBufferEmpty++;
+            if (removed == 0) { //buffer empty
+                stats.bufferEmpty.add(1);
                 continue; //unsuccessful
-            } else { //consumer pulled item from buffer
-                //successful in removing an item from the buffer
-                actionsPerformed[REF_ID]++;
+            } else { //consumer pulled items from buffer
+                recordLatencies(consumedItems.data(), removed, LATENCIES);
+                values = itemValues(consumedItems.data(), removed, itemScratch);
+                stats.primes.add((long long)countPrimes(values, removed, primeItems.get()));
+                //successful in removing items from the buffer
+                stats.actions.add((long long)removed);
+                traceItems(REF_ID, TRACE_REMOVE, values, removed, BUFFER->getHead());
             } //end else
         } //end while
     } //end if
     pthread_exit(nullptr);
 } //end consumer
 
+/*****************************************
+* replayProducer()
+*
+* @brief thread task to insert the numbers a recorded producer
+*        inserted, on the recorded schedule
+*
+* Used instead of producer() with --replay. Each item is inserted
+* at its recorded time after the run started, divided by
+* --replay-speed, or right after the last with --replay-speed=max.
+* Every recorded insert happened, so if the buffer is full the
+* producer counts it and blocks for room rather than dropping the
+* item. Replays move one item per action, whatever --batch is.
+* The thread is done when its schedule runs out or the run ends.
+*
+* @param param    the ThreadParam with the thread's index, its ThinkTime is unused
+*
+* @return 0       when the schedule or the simulation ends
+*****************************************/
+template<typename Item>
+void* replayProducer(void *param) {
+
+    //identify thread
+    const ThreadParam &PARAM = *static_cast<const ThreadParam *>(param);
+    const int PROCESS_ID = getpid();
+    const int REF_ID = PARAM.refId;
+    ThreadStats &stats = threadStats[REF_ID];
+    startGate.wait(); //until every thread has been created
+
+    BufferBase<Item> *const BUFFER = simulationBuffer<Item>()->forThread(REF_ID); //the thread's home shard with --shards
+    const vector<TraceRecord> &SCHEDULE = replaySchedules[REF_ID];
+    Item item{};                                   //the recorded number being put in the buffer
+    long long sleepStart;
+    timespec due{};
+
+    for (size_t next = 0; next < SCHEDULE.size() && running; next++) {
+        //waits for the item's turn
+        if (replaySpeed > 0) {
+            const long long DUE = runStart + (long long)((double)SCHEDULE[next].timestamp / replaySpeed);
+            due.tv_sec = DUE / NANOSECONDS_PER_SECOND;
+            due.tv_nsec = DUE % NANOSECONDS_PER_SECOND;
+            sleepStart = nowNanoseconds();
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR) {
+                //interrupted by a signal, the deadline hasn't moved
+            } //end while
+            stats.waitNanoseconds.add(nowNanoseconds() - sleepStart);
+        } //end if
+
+        setItemValue(item, (buffer_item)SCHEDULE[next].value);
+        stampItems(&item, 1);
+        if (!BUFFER->try_insert(item)) { //buffer full, wait for room
+            stats.bufferFull.add(1);
+            if (verboseMode == 'y' && logger != nullptr)
+                logger->log(REF_ID, LOG_FULL, 0, false, BUFFER);
+            else if (verboseMode == 'y')
+                printf("All buffers full. Producer %d waits.\n\n", PROCESS_ID);
+            sleepStart = nowNanoseconds();
+            const bool INSERTED = BUFFER->insert(item);
+            stats.waitNanoseconds.add(nowNanoseconds() - sleepStart);
+            if (!INSERTED)
+                break; //closed, the simulation is over
+        } //end if
+
+        //successful in putting the item in the buffer
+        stats.actions.add(1);
+        traceItems(REF_ID, TRACE_INSERT, &item, 1, BUFFER->getTail());
+        if (verboseMode == 'y' && logger != nullptr)
+            logger->log(REF_ID, LOG_INSERT, itemValue(item), false, BUFFER);
+        else if (verboseMode == 'y')
+            displayBuffer<Item>("Producer " + to_string(PROCESS_ID) + " writes " + to_string(itemValue(item)), BUFFER->getHead(), BUFFER->getTail());
+    } //end for
+    pthread_exit(nullptr);
+} //end replayProducer
+
+/*****************************************
+ * spawnThreads()
+ *
+ * @brief creates one spawner's share of the simulation's threads
+ *
+ * With hundreds of threads, creating them one after another from
+ * main() takes long enough to skew who starts first, so several
+ * spawners each create a slice of them. Every thread waits at the
+ * start gate until main() opens it, so none starts early either way.
+ *
+ * @param param the SpawnJob to create
+ *
+ * @return nullptr when its threads have been created
+ *****************************************/
+void* spawnThreads(void *param) {
+    const SpawnJob &JOB = *static_cast<const SpawnJob *>(param);
+    ThreadPlan &plan = *JOB.plan;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (plan.stackBytes > 0)
+        pthread_attr_setstacksize(&attr, plan.stackBytes);
+    for (int i = JOB.first; i < JOB.last; i++) {
+        const bool IS_PRODUCER = i < plan.numProducers;
+        if (!(IS_PRODUCER ? plan.runProducers : plan.runConsumers))
+            continue; //another process runs this side
+        pinToCpu(&attr, plan.cpus[i]);
+        plan.created[i] = pthread_create(&plan.tid[i], &attr, IS_PRODUCER ? plan.producer : plan.consumer, &plan.params[i]) == 0;
+    } //end for
+    pthread_attr_destroy(&attr);
+    return nullptr;
+} //end spawnThreads
 
 /*****************************************
- * numberProcess()
+ * scaleConsumers()
+ *
+ * @brief thread task that resizes the pool of working consumers
  *
- * @brief identifies the thread calling it by
- *        giving it a unique ID to its type
+ * Every --autoscale-ms, samples how full the buffer is and how
+ * many times producers found it full and consumers found it empty
+ * since the last sample, and hands them to the ConsumerScaler,
+ * which wakes or parks consumers.
  *
- * Processes that give 1 as an argument identify as a producer
- * Processes that give 2 as an argument identify as a consumer
- * For each type the function will issue a unique ID for the
- * thread type, but are not unique to the other type.
+ * @param param unused
  *
+ * @return nullptr when the simulation ends
+ *****************************************/
+template<typename Item>
+void* scaleConsumers(void *) {
+    BufferBase<Item> *const BUFFER = simulationBuffer<Item>();
+    const int NUM_PRODUCERS = scaler->getFirstId(); //consumers are numbered right after the producers
+    const int NUM_CONSUMERS = scaler->getMaximum();
+    timespec interval{};
+    interval.tv_sec = scaleIntervalMs / 1000;
+    interval.tv_nsec = (scaleIntervalMs % 1000) * 1000000;
+    long long lastFull = 0;
+    long long lastEmpty = 0;
+
+    while (running) { //until signalled to stop by main()
+        nanosleep(&interval, nullptr);
+        const long long FULLS = sumStats(threadStats, NUM_PRODUCERS).bufferFull;
+        const long long EMPTIES = sumStats(threadStats + NUM_PRODUCERS, NUM_CONSUMERS).bufferEmpty;
+        scaler->observe((double)BUFFER->getSize() / BUFFER->getCapacity(), FULLS - lastFull, EMPTIES - lastEmpty);
+        lastFull = FULLS;
+        lastEmpty = EMPTIES;
+    } //end while
+    return nullptr;
+} //end scaleConsumers
+
+/*****************************************
+ * traceItems()
  *
- * @param PROCESS_TYPE Identifies process type
+ * @brief writes items a thread just moved to the trace, with --record
  *
- * @return ref_ID the identifying number of the process within its type
+ * @param REF_ID the thread that moved them
+ * @param OP     TRACE_INSERT or TRACE_REMOVE
+ * @param ITEMS  the items (or their numbers) moved
+ * @param COUNT  how many were moved
+ * @param SLOT   the buffer's tail after an insert, or head after a remove
  *****************************************/
-int numberProcess(const int PROCESS_TYPE) {
+template<typename Item>
+void traceItems(const int REF_ID, const TraceOp OP, const Item *ITEMS, const size_t COUNT, const int SLOT) {
+    if (recorder == nullptr)
+        return;
+    for (size_t i = 0; i < COUNT; i++) {
+        recorder->record(REF_ID, OP, itemValue(ITEMS[i]), SLOT);
+    } //end for
+} //end traceItems
 
+/*****************************************
+ * simulationBuffer()
+ *
+ * @brief the buffer threads moving Item use
+ *
+ * @return buffer for plain items, stampedBuffer for stamped items
+ *****************************************/
+template<>
+BufferBase<buffer_item>* simulationBuffer<buffer_item>() { return buffer; }
 
-    sem_wait(&refGeneratorMutex);       // start critical
-        int ref_ID = -1; //pessimistic
-        if (PROCESS_TYPE == PRODUCER_TAG) { //thread identifies as producer
-            ref_ID = producer_ID;
-            producer_ID += 1;
-        } //end if
+template<>
+BufferBase<StampedItem>* simulationBuffer<StampedItem>() { return stampedBuffer; }
 
-        if (PROCESS_TYPE == CONSUMER_TAG) { //thread identifies as consumer
-            ref_ID = consumer_ID;
-            consumer_ID += 1;
+/*****************************************
+ * putItems()
+ *
+ * @brief inserts a producer's batch the way --overflow and
+ *        --producer-wait say to
+ *
+ * Time spent blocked on the buffer is counted as waiting. Items
+ * that don't fit are counted as dropped, and items the policy
+ * pushed out of the buffer as evicted or overwritten.
+ *
+ * @param BUFFER the buffer to insert into
+ * @param ITEMS  the batchSize items to insert
+ * @param stats  **REFERENCE** the producer's counters
+ *
+ * @return the number of items inserted (0 if none fit in time)
+ *****************************************/
+template<typename Item>
+size_t putItems(BufferBase<Item> *BUFFER, const Item *ITEMS, ThreadStats &stats) {
+    size_t inserted;
+    if (overflowPolicy == OVERFLOW_DROP_OLDEST || overflowPolicy == OVERFLOW_OVERWRITE) { //every item goes in
+        size_t lost = 0;
+        for (size_t i = 0; i < batchSize; i++) {
+            lost += overflowPolicy == OVERFLOW_DROP_OLDEST ? BUFFER->insert_evicting(ITEMS[i]) : BUFFER->insert_overwriting(ITEMS[i]);
+        } //end for
+        if (lost > 0) { //the buffer was full
+            stats.bufferFull.add(1);
+            (overflowPolicy == OVERFLOW_DROP_OLDEST ? stats.evicted : stats.overwritten).add((long long)lost);
         } //end if
-    sem_post(&refGeneratorMutex);      // end critical
-    return ref_ID;
-} //end numberProcess
+        return batchSize;
+    } //end if
+
+    if (producerWait == WAIT_TRY) {
+        if (batchSize == 1)
+            inserted = BUFFER->try_insert(ITEMS[0]) ? 1 : 0;
+        else
+            inserted = BUFFER->buffer_insert_items(ITEMS, batchSize);
+        stats.dropped.add((long long)(batchSize - inserted));
+        return inserted;
+    } //end if
+
+    const long long START = nowNanoseconds();
+    const long long DEADLINE = producerWait == WAIT_BLOCK ? NO_DEADLINE : START + waitNanoseconds;
+    if (batchSize == 1)
+        inserted = BUFFER->insert_until(ITEMS[0], DEADLINE) ? 1 : 0;
+    else
+        inserted = BUFFER->insert_items_until(ITEMS, batchSize, DEADLINE);
+    stats.waitNanoseconds.add(nowNanoseconds() - START);
+    stats.dropped.add((long long)(batchSize - inserted));
+    return inserted;
+} //end putItems
+
+/*****************************************
+ * takeItems()
+ *
+ * @brief removes up to a batch for a consumer the way --consumer-wait says to
+ *
+ * Time spent blocked on the buffer is counted as waiting.
+ *
+ * @param BUFFER the buffer to remove from
+ * @param items  REFERENCE to where up to batchSize items are stored
+ * @param stats  **REFERENCE** the consumer's counters
+ *
+ * @return the number of items removed (0 if none came in time)
+ *****************************************/
+template<typename Item>
+size_t takeItems(BufferBase<Item> *BUFFER, Item *items, ThreadStats &stats) {
+    if (consumerWait == WAIT_TRY) {
+        if (batchSize == 1)
+            return BUFFER->try_remove(&items[0]) ? 1 : 0;
+        return BUFFER->buffer_remove_items(items, batchSize);
+    } //end if
+
+    const long long START = nowNanoseconds();
+    const long long DEADLINE = consumerWait == WAIT_BLOCK ? NO_DEADLINE : START + waitNanoseconds;
+    size_t removed;
+    if (batchSize == 1)
+        removed = BUFFER->remove_until(&items[0], DEADLINE) ? 1 : 0;
+    else
+        removed = BUFFER->remove_items_until(items, batchSize, DEADLINE);
+    stats.waitNanoseconds.add(nowNanoseconds() - START);
+    return removed;
+} //end takeItems
+
+/*****************************************
+ * parseWaitMode()
+ *
+ * @brief reads a wait mode from the command line
+ *
+ * @param NAME   try, block or timed
+ * @param result REFERENCE to where the mode is stored
+ *
+ * @return true if NAME is a known mode
+ *****************************************/
+bool parseWaitMode(const string &NAME, WaitMode &result) {
+    if (NAME == "try") result = WAIT_TRY;
+    else if (NAME == "block") result = WAIT_BLOCK;
+    else if (NAME == "timed") result = WAIT_TIMED;
+    else return false;
+    return true;
+} //end parseWaitMode
+
+/*****************************************
+ * parseOverflowPolicy()
+ *
+ * @brief reads an overflow policy from the command line
+ *
+ * @param NAME   block, drop-newest, drop-oldest or overwrite
+ * @param result REFERENCE to where the policy is stored
+ *
+ * @return true if NAME is a known policy
+ *****************************************/
+bool parseOverflowPolicy(const string &NAME, OverflowPolicy &result) {
+    if (NAME == "block") result = OVERFLOW_BLOCK;
+    else if (NAME == "drop-newest") result = OVERFLOW_DROP_NEWEST;
+    else if (NAME == "drop-oldest") result = OVERFLOW_DROP_OLDEST;
+    else if (NAME == "overwrite") result = OVERFLOW_OVERWRITE;
+    else return false;
+    return true;
+} //end parseOverflowPolicy
+
+// the command line name of an overflow policy, for the final stats
+string overflowPolicyName(const OverflowPolicy POLICY) {
+    switch (POLICY) {
+        case OVERFLOW_BLOCK: return "block";
+        case OVERFLOW_DROP_OLDEST: return "drop-oldest";
+        case OVERFLOW_OVERWRITE: return "overwrite";
+        default: return "drop-newest";
+    } //end switch
+} //end overflowPolicyName
 
 
 /*****************************************
@@ -373,7 +1201,7 @@ int numberProcess(const int PROCESS_TYPE) {
  * values stored in the buffer, and the location of the next read
  * and write actions to happen to the buffer
  *
- * @pre there exists a buffer with a size of 5
+ * @pre there exists a buffer
  *
  * @param TITLE **REFERENCE** the description of the last action performed on the buffer
  * @param head Location of where the next read action will occur
@@ -381,7 +1209,10 @@ int numberProcess(const int PROCESS_TYPE) {
  *
  * @return void
  *****************************************/
+template<typename Item>
 void displayBuffer(const string &TITLE, const int head, const int tail) {
+    BufferBase<Item> *const BUFFER = simulationBuffer<Item>();
+
     //LOCATE WHERE HEAD AND TAIL ARE IN THE BUFFER
     int i= 0 ;
     const string SPACE = "        ";
@@ -409,14 +1240,28 @@ void displayBuffer(const string &TITLE, const int head, const int tail) {
 
     } //end else
 
+    //LIST EVERY SLOT IN THE BUFFER
+    const int CAPACITY = BUFFER->getCapacity();
+    string slots, dividers;
+    char slot[32];
+    for (i = 0; i < CAPACITY; i++) {
+        const buffer_item ITEM = itemValue(BUFFER->getItem(i));
+        if (ITEM == NullItem<buffer_item>::value())
+            snprintf(slot, sizeof(slot), "\t%5d", NULL_ITEM);
+        else
+            snprintf(slot, sizeof(slot), "\t" BUFFER_ITEM_FORMAT, ITEM);
+        slots.append(slot);
+        dividers.append(i == 0 ? "  ----" : "    ----");
+    } //end for
+
     //DISPLAY TO CONSOLE
     printf("%s\n"
         "(buffers occupied: %d)\n"
-           "buffers:\t%5d\t%5d\t%5d\t%5d\t%5d\n"
-           "\t\t\t  ----    ----    ----    ----    ----\n"
+           "buffers:%s\n"
+           "\t\t\t%s\n"
            "\t\t\t   %s\n\n"
-           ,TITLE.c_str(),buffer.size,buffer.buffer[0],buffer.buffer[1],buffer.buffer[2],buffer.buffer[3],buffer.buffer[4]
-           ,pointerLocations.c_str());
+           ,TITLE.c_str(),BUFFER->getSize(),slots.c_str()
+           ,dividers.c_str(),pointerLocations.c_str());
 } //end displayBuffer
 
 /*****************************************
@@ -429,8 +1274,11 @@ void displayBuffer(const string &TITLE, const int head, const int tail) {
  * When the simulation is over, will print the following items to the console:
  *      -Simulation Time
  *      -Maximum Sleep Time of a Thread
+ *      -How threads paused between actions
+ *      -How threads were pinned to CPUs
  *      -Number of Producers
  *      -Number of Consumers
+ *      -Random Seed (pass it back with --seed to repeat the run)
  *      -Size of the Buffer
  *      -Number of Items Produced
  *      -How many items each thread produced (that was a producer)
@@ -439,6 +1287,13 @@ void displayBuffer(const string &TITLE, const int head, const int tail) {
  *      -Number of items left in the buffer when the simulation terminated
  *      -Number of times the buffer was empty when a consumer tried to access it during the simulation
  *      -Number of times the buffer was full when a producer tried to access it during the simulation
+ *      -Number of consumed items that were prime
+ *      -The overflow policy, and how many items were dropped, evicted or overwritten because the buffer was full
+ *      -Total time producers and consumers spent sleeping or waiting
+ *      -How many consumers the autoscaler kept working, and how often it changed (with --autoscale)
+ *      -How many items consumers took from each priority lane (with --lanes)
+ *      -Verbose events the writer thread couldn't keep up with (with --log=async)
+ *      -Percentiles of how long items waited in the buffer (with --latency)
  *
  * @pre the simulation has completed
  *
@@ -446,61 +1301,116 @@ void displayBuffer(const string &TITLE, const int head, const int tail) {
  * @param MAX_SLEEP_TIME  **REFERENCE** the user defined amount of time threads are allowed to sleep for
  * @param NUM_PRODUCERS   **REFERENCE** the user defined amount of Producers existed in the simulation
  * @param NUM_CONSUMERS   **REFERENCE** the user defined amount of Consumers existed in the simulation
+ * @param THINK_TIME      **REFERENCE** how threads paused between actions
  *
  * @return void
  *****************************************/
-void displayFinalStats (const int &SIMULATION_TIME, const int &MAX_SLEEP_TIME, const int &NUM_PRODUCERS, const int &NUM_CONSUMERS) {
+void displayFinalStats (const int &SIMULATION_TIME, const int &MAX_SLEEP_TIME, const int &NUM_PRODUCERS, const int &NUM_CONSUMERS, const ThinkTime &THINK_TIME) {
     //SUM TOTAL OF PRODUCED AND CONSUMED ITEMS
-    int totalProduced (0), totalConsumed (0);
+    const StatTotals PRODUCERS = sumStats(threadStats, NUM_PRODUCERS);
+    const StatTotals CONSUMERS = sumStats(threadStats + NUM_PRODUCERS, NUM_CONSUMERS);
+    const int CAPACITY = measureLatency ? stampedBuffer->getCapacity() : buffer->getCapacity();
+    const int REMAINING = measureLatency ? stampedBuffer->getSize() : buffer->getSize();
     int index;
-    for (index = 0; index < NUM_PRODUCERS; index++) {
-        totalProduced += actionsPerformed[index];
-    } //end for
-    for (index = 0; index < NUM_CONSUMERS; index++) {
-        totalConsumed += actionsPerformed[index+NUM_PRODUCERS];
-    } //end for
 
     //FORMAT DISPLAY MESSAGE
     string finalMessage =   "PRODUCER / CONSUMER SIMULATION COMPLETE \n"
                             "========================================\n"
                             "Simulation Time:\t\t\t\t\t\t" + to_string(SIMULATION_TIME) + "\n"
                             "Maximum Thread Sleep Time:\t\t\t\t" + to_string(MAX_SLEEP_TIME) + "\n"
+                            "Thread Think Time:\t\t\t\t\t\t" + THINK_TIME.describe() + "\n"
+                            "Thread Placement:\t\t\t\t\t\t" + placementName + "\n"
                             "Number of Producer Threads:\t\t\t\t" + to_string(NUM_PRODUCERS) + "\n"
                             "Number of Consumer Threads:\t\t\t\t" + to_string(NUM_CONSUMERS) + "\n"
-                            "Size of Buffer:\t\t\t\t\t\t\t" + to_string(buffer.size) + "\n"
+                            "Random Seed:\t\t\t\t\t\t\t" + to_string(randomSeed) + "\n"
+                            "Size of Buffer:\t\t\t\t\t\t\t" + to_string(CAPACITY) + "\n"
                             "\n"
-                            "Total Number of Items Produced:\t\t\t" + to_string(totalProduced) + "\n";
+                            "Total Number of Items Produced:\t\t\t" + to_string(PRODUCERS.actions) + "\n";
     for (index = 0; index < NUM_PRODUCERS; index++) {
-        finalMessage +=     "\tThread " + to_string(index) + ":\t\t\t\t\t\t\t" + to_string(actionsPerformed[index]) + "\n";
+        finalMessage +=     "\tThread " + to_string(index) + ":\t\t\t\t\t\t\t" + to_string(threadStats[index].actions.get()) + "\n";
     } //end for
     finalMessage +=         "\n"
-                            "Total Number of Items Consumed:\t\t\t" + to_string(totalConsumed) + "\n";
+                            "Total Number of Items Consumed:\t\t\t" + to_string(CONSUMERS.actions) + "\n";
     for (; index < NUM_CONSUMERS + NUM_PRODUCERS; index++) {
-        finalMessage +=     "\tThread " + to_string(index) + ":\t\t\t\t\t\t\t" + to_string(actionsPerformed[index]) + "\n";
+        finalMessage +=     "\tThread " + to_string(index) + ":\t\t\t\t\t\t\t" + to_string(threadStats[index].actions.get()) + "\n";
     } //end for
 
     finalMessage +=        "\n"
-                           "Number Of Items Remaining in Buffer:\t" + to_string(buffer.size) + "\n"
-                           "Number Of Times Buffer was Full:\t\t" + to_string(countBufferFull) + "\n"
-                           "Number Of Times Buffer was Empty:\t\t" + to_string(countBufferEmpty) + "\n";
+                           "Number Of Items Remaining in Buffer:\t" + to_string(REMAINING) + "\n"
+                           "Number Of Times Buffer was Full:\t\t" + to_string(PRODUCERS.bufferFull) + "\n"
+                           "Number Of Times Buffer was Empty:\t\t" + to_string(CONSUMERS.bufferEmpty) + "\n"
+                           "Number Of Prime Numbers Consumed:\t\t" + to_string(CONSUMERS.primes) + "\n"
+                           "Overflow Policy:\t\t\t\t\t\t" + overflowPolicyName(overflowPolicy) + "\n"
+                           "\tItems Dropped (drop-newest):\t\t" + to_string(PRODUCERS.dropped) + "\n"
+                           "\tItems Evicted (drop-oldest):\t\t" + to_string(PRODUCERS.evicted) + "\n"
+                           "\tItems Overwritten (overwrite):\t\t" + to_string(PRODUCERS.overwritten) + "\n"
+                           "Producer Time Spent Waiting (ms):\t\t" + to_string(PRODUCERS.waitNanoseconds / 1000000) + "\n"
+                           "Consumer Time Spent Waiting (ms):\t\t" + to_string(CONSUMERS.waitNanoseconds / 1000000) + "\n";
+    if (scaler != nullptr) {
+        finalMessage +=    "Consumers Working (min / max / peak / end):\t" + to_string(scaler->getMinimum()) + " / "
+                                + to_string(scaler->getMaximum()) + " / " + to_string(scaler->getPeak()) + " / "
+                                + to_string(scaler->getActive()) + "\n"
+                           "Times Consumers Were Added / Parked:\t" + to_string(scaler->getScaleUps()) + " / "
+                                + to_string(scaler->getScaleDowns()) + "\n";
+    } //end if
+    finalMessage +=        measureLatency ? describeLanes(stampedBuffer) : describeLanes(buffer);
+    if (logger != nullptr) {
+        finalMessage +=    "Verbose Events Dropped:\t\t\t\t\t" + to_string(logger->dropped()) + "\n";
+    } //end if
+
+    if (measureLatency) { //merge every consumer's histogram into one
+        LatencyHistogram latencies;
+        for (index = NUM_PRODUCERS; index < NUM_CONSUMERS + NUM_PRODUCERS; index++) {
+            latencies.merge(latencyHistograms[index]);
+        } //end for
+        finalMessage +=    "\n"
+                           "Item Latency, Insert to Remove (ns):\n"
+                           "\tp50:\t\t\t\t" + to_string(latencies.percentile(0.50)) + "\n"
+                           "\tp90:\t\t\t\t" + to_string(latencies.percentile(0.90)) + "\n"
+                           "\tp99:\t\t\t\t" + to_string(latencies.percentile(0.99)) + "\n"
+                           "\tp99.9:\t\t\t\t" + to_string(latencies.percentile(0.999)) + "\n"
+                           "\tmax:\t\t\t\t" + to_string(latencies.max()) + "\n";
+    } //end if
 
     //DISPLAY
     cout << finalMessage;
 } //end displayFinalStats
 
+/*****************************************
+ * describeLanes
+ *
+ * @brief the final stats of a buffer's priority lanes
+ *
+ * @param BUFFER the simulation's buffer
+ *
+ * @return how many items were taken from each lane, highest first,
+ *         and how often a lower lane was served on credit
+ * @return an empty string if the buffer has no lanes
+ *****************************************/
+template<typename Item>
+string describeLanes(BufferBase<Item> *BUFFER) {
+    const PriorityBuffer<Item> *PRIORITY = dynamic_cast<const PriorityBuffer<Item> *>(BUFFER);
+    if (PRIORITY == nullptr)
+        return "";
+    string lanes =          "Items Consumed per Lane (highest first):\n";
+    for (size_t lane = PRIORITY->laneCount(); lane > 0; lane--) {
+        lanes +=            "\tLane " + to_string(lane - 1) + ":\t\t\t\t\t\t\t" + to_string(PRIORITY->getTaken(lane - 1)) + "\n";
+    } //end for
+    lanes +=                "Lanes Served on Credit (every " + to_string(PRIORITY->getCreditLimit()) + "):\t"
+                                + to_string(PRIORITY->getCreditServes()) + "\n";
+    return lanes;
+} //end describeLanes
+
 /*****************************************
  * isPrime
  *
  * @brief evaluates if the given item is prime
  *
- * The program cycles through potential factors of
- * a number until it gets to the square root of the
- * number, which can be used in the proof that the
- * number is prime or not
+ * Looks the item up in the sieve built by main(), which
+ * covers every number producers can generate. Anything
+ * outside of it is checked with trial division.
  *
- * ** This function was referenced from the article:
- * https://www.geeksforgeeks.org/c-program-to-check-prime-number/
- * **
+ * @pre primeSieve has been built
  *
  * @param item the integer to be distinguished if it is prime or not
  *
@@ -509,11 +1419,75 @@ void displayFinalStats (const int &SIMULATION_TIME, const int &MAX_SLEEP_TIME, c
  *
  *****************************************/
 bool isPrime(buffer_item item) {
-    if (item == 1 || item == 0) return false;
-    for (int i = 2; i * i <= item; i++) {
-        if (item % i == 0)
-            return false;
+    if (item <= 1) return false;
+    return primeSieve->isPrime((uint64_t)item);
+}
+
+/*****************************************
+ * countPrimes
+ *
+ * @brief evaluates which items of a batch are prime
+ *
+ * Single items go straight to isPrime(). Larger batches
+ * go through the SIMD kernel, which weeds out items with
+ * small factors for the whole batch at once.
+ *
+ * @pre primeSieve has been built
+ *
+ * @param ITEMS   the items to be distinguished if they are prime or not
+ * @param count   the number of items
+ * @param results REFERENCE to where true / false is stored for each item
+ *
+ * @return the number of items that are prime
+ *
+ *****************************************/
+size_t countPrimes(const buffer_item *ITEMS, size_t count, bool *results) {
+    if (count == 1) {
+        results[0] = isPrime(ITEMS[0]);
+    } else {
+        isPrimeBatch(ITEMS, count, *primeSieve, results);
+    } //end else
+
+    size_t primes = 0;
+    for (size_t i = 0; i < count; i++) {
+        primes += results[i];
     } //end for
-    return true;
+    return primes;
 }
 
+/*****************************************
+ * randomItem
+ *
+ * @brief generates a random item for a producer
+ *
+ * @param random **REFERENCE** the calling thread's random number generator
+ *
+ * @return a random number from 0 up to maxRandomNumber
+ *
+ *****************************************/
+buffer_item randomItem(Xoshiro256 &random) {
+    return (buffer_item)random.below((uint64_t)maxRandomNumber);
+}
+
+/*****************************************
+ * randomLane
+ *
+ * @brief picks the priority lane for a producer's batch
+ *
+ * Each lane is half as likely as the one below it, so most of
+ * the traffic is ordinary work in lane 0 and the highest lane
+ * gets the few urgent batches.
+ *
+ * @param random **REFERENCE** the calling thread's random number generator
+ *
+ * @return a lane from 0 up to laneCount - 1
+ *
+ *****************************************/
+int randomLane(Xoshiro256 &random) {
+    const uint64_t DRAW = random.below(((uint64_t)1 << laneCount) - 1) + 1; //lane k covers 2^(laneCount - 1 - k) draws
+    int lane = laneCount - 1;
+    for (uint64_t bound = 2; bound <= DRAW; bound <<= 1) {
+        lane--;
+    } //end for
+    return lane;
+}
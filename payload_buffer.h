@@ -0,0 +1,295 @@
+/**************************************************************************
+ *
+ *  Class Name: payload_buffer.h
+ *  Purpose:    Buffers that carry real work between threads: move-only
+ *              items built in place in raw slots, and large payloads
+ *              handed off by index out of a pre-allocated slab
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _PAYLOAD_BUFFER_H_DEFINED_
+#define _PAYLOAD_BUFFER_H_DEFINED_
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <semaphore.h>
+#include <utility>
+#include "buffer.h"
+
+typedef uint32_t slab_handle;               // the index of a payload in a PayloadSlab
+
+/***************************************************************
+ *
+ * @brief a circular buffer of move-only items
+ *
+ * BufferBase hands items around by value and shows any slot with
+ * getItem(), so every item type it carries has to be copyable and
+ * have a NullItem for empty slots. A PayloadBuffer has neither
+ * requirement: slots are raw storage, an item is built in place
+ * when it is inserted and destroyed when it is removed, and an
+ * empty slot holds nothing at all.
+ *
+ * Slots are reserved with a CAS on empty / full and items are
+ * moved in and out under a mutex, the same as the semaphore
+ * Buffer, and blocked threads wait the same way. If building or
+ * moving out an item throws, the mutex and the reservation are
+ * given back before the exception leaves, so the buffer is left
+ * as it was.
+ *
+ * @tparam T the type of item stored in the buffer, only needs to be movable
+ *
+ *****************************************************************/
+template<typename T>
+class PayloadBuffer {
+
+    // uninitialized room for one item
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    // CLASS DATA MEMBERS //
+    int size;                               // the number of items in the buffer
+    Ring<Slot, DYNAMIC_CAPACITY> buffer;    // the place where items are stored
+    int head;                               // location of the oldest item
+    int tail;                               // location of where the next item will go
+
+    sem_t freeMutex{};                      // semaphore that keeps track if a thread is accessing the buffer
+    std::atomic<int> empty;                 // how many empty slots producers can still reserve
+    std::atomic<int> full;                  // how many items consumers can still reserve
+    std::atomic<bool> closed{false};        // set once by close(), ends every blocking call
+    WaitPolicy notFull;                     // producers waiting for room wait here
+    WaitPolicy notEmpty;                    // consumers waiting for an item wait here
+
+    T* slotItem( const size_t SLOT ) { return std::launder(reinterpret_cast<T *>(buffer[SLOT].bytes)); }
+
+    // builds an item in the next slot after one has been reserved on empty
+    template<typename... Args>
+    void putReserved( Args &&...args ) {
+        sem_wait(&freeMutex);
+        {
+            try {
+                new (buffer[tail].bytes) T(std::forward<Args>(args)...);
+            } catch (...) { // nothing was built, give the mutex and the reserved slot back
+                sem_post(&freeMutex);
+                empty.fetch_add(1, std::memory_order_release);
+                notFull.notify(1);
+                throw;
+            } //end catch
+            tail = (int)buffer.wrap(tail + 1);
+            size++;
+        }
+        sem_post(&freeMutex);
+        full.fetch_add(1, std::memory_order_release);
+        notEmpty.notify(1);
+    }
+
+    // moves the oldest item out and destroys what is left of it after it has been reserved on full
+    void takeReserved( T *item ) {
+        sem_wait(&freeMutex);
+        {
+            T *oldest = slotItem(head);
+            try {
+                *item = std::move(*oldest);
+            } catch (...) { // the item stays in the buffer, give the mutex and the reserved item back
+                sem_post(&freeMutex);
+                full.fetch_add(1, std::memory_order_release);
+                notEmpty.notify(1);
+                throw;
+            } //end catch
+            oldest->~T();
+            head = (int)buffer.wrap(head + 1);
+            size--;
+        }
+        sem_post(&freeMutex);
+        empty.fetch_add(1, std::memory_order_release);
+        notFull.notify(1);
+    }
+
+    public:
+    /*****************************************
+     * PayloadBuffer Constructor
+     *
+     * @param capacity number of slots, none of which holds an item yet
+     *
+     ********************************************/
+    explicit PayloadBuffer( const size_t capacity )
+        : size(0), buffer(capacity), head(0), tail(0), empty((int)capacity), full(0) {
+        sem_init(&freeMutex, 0, 1);
+    }
+
+    // destroys the items nobody removed
+    ~PayloadBuffer() {
+        for (; size > 0; size--) {
+            slotItem(head)->~T();
+            head = (int)buffer.wrap(head + 1);
+        } //end for
+        sem_destroy(&freeMutex);
+    }
+
+    PayloadBuffer( const PayloadBuffer & ) = delete;
+    PayloadBuffer& operator=( const PayloadBuffer & ) = delete;
+
+    /*****************************************
+     * try_emplace()
+     *
+     * @brief builds an item straight into the next slot without blocking
+     *
+     * @param args what to construct the item from
+     *
+     * @return true if the item was built in the buffer
+     * @return false if the buffer was full (nothing is constructed)
+     *****************************************/
+    template<typename... Args>
+    bool try_emplace( Args &&...args ) {
+        if (Buffer<>::reserve(empty, 1) == 0) // the buffer is full
+            return false;
+        putReserved(std::forward<Args>(args)...);
+        return true;
+    }
+
+    // moves item into the buffer if there is room, item is left alone if not
+    bool try_insert( T &&item ) { return try_emplace(std::move(item)); }
+
+    /*****************************************
+     * insert_until()
+     *
+     * @brief moves an item into the buffer, waiting for room
+     *
+     * @param item     **REFERENCE** the item, only moved from if it was inserted
+     * @param DEADLINE nowNanoseconds() time to give up at (NO_DEADLINE waits for good)
+     *
+     * @return true if the item was inserted
+     * @return false if the deadline passed or the buffer was closed first
+     *****************************************/
+    bool insert_until( T &item, const long long DEADLINE ) {
+        return try_insert(std::move(item))
+            || notFull.waitUntil(DEADLINE, [&] { return try_insert(std::move(item)); }, [&] { return isClosed(); });
+    }
+
+    /*****************************************
+     * try_remove()
+     *
+     * @brief moves the oldest item out of the buffer without blocking
+     *
+     * @param item REFERENCE to where the item is moved to
+     *
+     * @return true if an item was removed
+     * @return false if the buffer was empty
+     *****************************************/
+    bool try_remove( T *item ) {
+        if (Buffer<>::reserve(full, 1) == 0) // the buffer is empty
+            return false;
+        takeReserved(item);
+        return true;
+    }
+
+    // try_remove(), waiting for an item
+    bool remove_until( T *item, const long long DEADLINE ) {
+        return try_remove(item)
+            || notEmpty.waitUntil(DEADLINE, [&] { return try_remove(item); }, [&] { return isClosed(); });
+    }
+
+    // wakes every blocked thread and makes blocking calls give up from now on
+    void close() {
+        closed.store(true, std::memory_order_release);
+        notFull.wakeAll();
+        notEmpty.wakeAll();
+    }
+    bool isClosed() const { return closed.load(std::memory_order_acquire); }
+
+    // how blocked threads wait, set before any thread uses the buffer
+    void setWaitStrategy( const WaitStrategy STRATEGY ) {
+        notFull.setStrategy(STRATEGY);
+        notEmpty.setStrategy(STRATEGY);
+    }
+
+    // DISPLAY ACCESSORS //
+    int getCapacity() const { return (int)buffer.capacity(); }
+    int getSize() const { return size; }
+};
+
+/***************************************************************
+ *
+ * @brief large payloads handed between threads by index
+ *
+ * Every payload is allocated once, up front, in one slab. A
+ * producer acquires a free payload, fills it in where it lies,
+ * and publishes its handle; a consumer removes the handle, works
+ * on the payload where it lies, and releases it for reuse. Only
+ * the 4 byte handles go through a ring, so a message of any size
+ * moves between threads without being copied or allocated.
+ *
+ * Free and published handles are each kept in a semaphore Buffer
+ * with room for every handle, so publishing never fails, and a
+ * producer that runs out of free payloads waits on the free ring
+ * the same way it would wait on a full buffer.
+ *
+ * @tparam T the type of payload, built once with T()
+ *
+ *****************************************************************/
+template<typename T>
+class PayloadSlab {
+
+    // CLASS DATA MEMBERS //
+    std::unique_ptr<T[]> payloads;          // every payload there will ever be
+    Buffer<slab_handle> freeHandles;        // payloads no thread holds, ready to be acquired
+    Buffer<slab_handle> readyHandles;       // published payloads, oldest first
+
+    public:
+    /*****************************************
+     * PayloadSlab Constructor
+     *
+     * @param capacity the number of payloads, and so of messages that can be in flight
+     *
+     ********************************************/
+    explicit PayloadSlab( const size_t capacity )
+        : payloads(new T[capacity]()), freeHandles(capacity), readyHandles(capacity) {
+        for (size_t i = 0; i < capacity; i++) {
+            freeHandles.try_insert((slab_handle)i);
+        } //end for
+    }
+
+    // the payload a handle refers to
+    T& operator[]( const slab_handle HANDLE ) { return payloads[HANDLE]; }
+    const T& operator[]( const slab_handle HANDLE ) const { return payloads[HANDLE]; }
+
+    // takes a free payload for a producer to fill, false if every payload is in flight
+    bool try_acquire( slab_handle *handle ) { return freeHandles.try_remove(handle); }
+    bool acquire_until( slab_handle *handle, const long long DEADLINE ) { return freeHandles.remove_until(handle, DEADLINE); }
+
+    // hands a filled payload to the consumers; there is a slot for every handle, so it always fits
+    void publish( const slab_handle HANDLE ) { readyHandles.try_insert(HANDLE); }
+
+    // takes the oldest published payload for a consumer to work on
+    bool try_remove( slab_handle *handle ) { return readyHandles.try_remove(handle); }
+    bool remove_until( slab_handle *handle, const long long DEADLINE ) { return readyHandles.remove_until(handle, DEADLINE); }
+
+    // returns a payload the consumer is done with, so it can be acquired again
+    void release( const slab_handle HANDLE ) { freeHandles.try_insert(HANDLE); }
+
+    // wakes every blocked thread and makes blocking calls give up from now on
+    void close() {
+        freeHandles.close();
+        readyHandles.close();
+    }
+
+    // how blocked threads wait, set before any thread uses the slab
+    void setWaitStrategy( const WaitStrategy STRATEGY ) {
+        freeHandles.setWaitStrategy(STRATEGY);
+        readyHandles.setWaitStrategy(STRATEGY);
+    }
+
+    // DISPLAY ACCESSORS //
+    int getCapacity() const { return freeHandles.getCapacity(); }
+    int getSize() const { return readyHandles.getSize(); }          // published payloads waiting for a consumer
+};
+
+#endif // _PAYLOAD_BUFFER_H_DEFINED_
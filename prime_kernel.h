@@ -0,0 +1,246 @@
+/**************************************************************************
+ *
+ *  Class Name: prime_kernel.h
+ *  Purpose:    Checks a whole batch of consumed items for primality at
+ *              once, using SIMD to rule out numbers with small factors
+ *              before the expensive checks in primes.h
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _PRIME_KERNEL_H_DEFINED_
+#define _PRIME_KERNEL_H_DEFINED_
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "primes.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PRIME_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+#define WHEEL_PRIMES (17)                   // odd primes 3 through 61
+#define WHEEL_SQUARE (67 * 67)              // survivors below this have no factor under their square root
+#define KERNEL_CHUNK (64)                   // candidates per mask word
+
+/***************************************************************
+ *
+ * @brief one odd prime of the wheel, set up for division by
+ *        multiplication
+ *
+ * For odd p, n is a multiple of p exactly when
+ * n * p^-1 (mod 2^32) <= (2^32 - 1) / p, which is one multiply
+ * and one compare per lane instead of a division.
+ *
+ *****************************************************************/
+struct WheelPrime {
+    uint32_t prime;                         // p
+    uint32_t inverse;                       // p^-1 mod 2^32
+    uint32_t bound;                         // (2^32 - 1) / p
+};
+
+constexpr uint32_t inverse32( const uint32_t P ) {
+    uint32_t inverse = P; // correct to 3 bits, each step doubles that
+    for (int i = 0; i < 4; i++) {
+        inverse *= 2 - P * inverse;
+    } //end for
+    return inverse;
+}
+
+constexpr WheelPrime wheelPrime( const uint32_t P ) { return {P, inverse32(P), UINT32_MAX / P}; }
+
+static constexpr WheelPrime WHEEL[WHEEL_PRIMES] = {
+    wheelPrime(3), wheelPrime(5), wheelPrime(7), wheelPrime(11), wheelPrime(13), wheelPrime(17),
+    wheelPrime(19), wheelPrime(23), wheelPrime(29), wheelPrime(31), wheelPrime(37), wheelPrime(41),
+    wheelPrime(43), wheelPrime(47), wheelPrime(53), wheelPrime(59), wheelPrime(61)
+};
+
+/*****************************************
+ * wheelMaskScalar()
+ *
+ * @brief marks which candidates have no factor in the wheel
+ *
+ * the reference kernel, used when the CPU has no SIMD
+ * support and to define what the SIMD kernels must match
+ *
+ * @param CANDIDATES the numbers to check
+ * @param COUNT      the number of candidates (at most KERNEL_CHUNK)
+ *
+ * @return a mask with bit i set if candidate i may be prime
+ *****************************************/
+inline uint64_t wheelMaskScalar( const uint32_t *CANDIDATES, const size_t COUNT ) {
+    uint64_t survivors = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        const uint32_t N = CANDIDATES[i];
+        bool composite = N <= 1 || ((N & 1) == 0 && N != 2);
+        for (const WheelPrime &WHEEL_PRIME : WHEEL) {
+            composite |= N * WHEEL_PRIME.inverse <= WHEEL_PRIME.bound && N != WHEEL_PRIME.prime;
+        } //end for
+        if (!composite)
+            survivors |= 1ULL << i;
+    } //end for
+    return survivors;
+} //end wheelMaskScalar
+
+#ifdef PRIME_KERNEL_X86
+/*****************************************
+ * wheelMaskSSE2()
+ *
+ * @brief wheelMaskScalar() four candidates at a time
+ *
+ * SSE2 has neither a 32-bit low multiply nor an unsigned
+ * compare, so both are built out of what it does have
+ *****************************************/
+inline __m128i multiplyLow32SSE2( const __m128i A, const __m128i B ) {
+    const __m128i EVEN = _mm_mul_epu32(A, B);
+    const __m128i ODD = _mm_mul_epu32(_mm_srli_epi64(A, 32), _mm_srli_epi64(B, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(EVEN, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(ODD, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// all ones in each lane where A > B, comparing as unsigned
+inline __m128i greaterUnsignedSSE2( const __m128i A, const __m128i B ) {
+    const __m128i SIGN = _mm_set1_epi32((int)0x80000000);
+    return _mm_cmpgt_epi32(_mm_xor_si128(A, SIGN), _mm_xor_si128(B, SIGN));
+}
+
+inline uint64_t wheelMaskSSE2( const uint32_t *CANDIDATES, const size_t COUNT ) {
+    const __m128i ONE = _mm_set1_epi32(1);
+    const __m128i TWO = _mm_set1_epi32(2);
+    const __m128i ZERO = _mm_setzero_si128();
+    uint64_t survivors = 0;
+
+    for (size_t i = 0; i < COUNT; i += 4) {
+        uint32_t lanes[4] = {0, 0, 0, 0}; // zero pads the last group, and zero is never prime
+        memcpy(lanes, CANDIDATES + i, (COUNT - i < 4 ? COUNT - i : 4) * sizeof(uint32_t));
+        const __m128i N = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes));
+
+        //n <= 1, or even and not 2
+        __m128i composite = _mm_andnot_si128(greaterUnsignedSSE2(N, ONE), _mm_set1_epi32(-1));
+        const __m128i EVEN = _mm_cmpeq_epi32(_mm_and_si128(N, ONE), ZERO);
+        composite = _mm_or_si128(composite, _mm_andnot_si128(_mm_cmpeq_epi32(N, TWO), EVEN));
+
+        for (const WheelPrime &WHEEL_PRIME : WHEEL) {
+            const __m128i PRODUCT = multiplyLow32SSE2(N, _mm_set1_epi32((int)WHEEL_PRIME.inverse));
+            const __m128i DIVIDES = _mm_andnot_si128(greaterUnsignedSSE2(PRODUCT, _mm_set1_epi32((int)WHEEL_PRIME.bound)), _mm_set1_epi32(-1));
+            const __m128i IS_PRIME = _mm_cmpeq_epi32(N, _mm_set1_epi32((int)WHEEL_PRIME.prime));
+            composite = _mm_or_si128(composite, _mm_andnot_si128(IS_PRIME, DIVIDES));
+        } //end for
+
+        const uint64_t LANE_BITS = (uint64_t)(~_mm_movemask_ps(_mm_castsi128_ps(composite)) & 0xF);
+        survivors |= LANE_BITS << i;
+    } //end for
+    return survivors & (COUNT == 64 ? ~0ULL : (1ULL << COUNT) - 1);
+} //end wheelMaskSSE2
+
+/*****************************************
+ * wheelMaskAVX2()
+ *
+ * @brief wheelMaskScalar() eight candidates at a time
+ *****************************************/
+__attribute__((target("avx2")))
+inline uint64_t wheelMaskAVX2( const uint32_t *CANDIDATES, const size_t COUNT ) {
+    const __m256i ONE = _mm256_set1_epi32(1);
+    const __m256i TWO = _mm256_set1_epi32(2);
+    const __m256i ZERO = _mm256_setzero_si256();
+    uint64_t survivors = 0;
+
+    for (size_t i = 0; i < COUNT; i += 8) {
+        uint32_t lanes[8] = {0, 0, 0, 0, 0, 0, 0, 0}; // zero pads the last group, and zero is never prime
+        memcpy(lanes, CANDIDATES + i, (COUNT - i < 8 ? COUNT - i : 8) * sizeof(uint32_t));
+        const __m256i N = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes));
+
+        //n <= 1, or even and not 2
+        __m256i composite = _mm256_cmpeq_epi32(_mm256_max_epu32(N, ONE), ONE);
+        const __m256i EVEN = _mm256_cmpeq_epi32(_mm256_and_si256(N, ONE), ZERO);
+        composite = _mm256_or_si256(composite, _mm256_andnot_si256(_mm256_cmpeq_epi32(N, TWO), EVEN));
+
+        for (const WheelPrime &WHEEL_PRIME : WHEEL) {
+            const __m256i PRODUCT = _mm256_mullo_epi32(N, _mm256_set1_epi32((int)WHEEL_PRIME.inverse));
+            const __m256i BOUND = _mm256_set1_epi32((int)WHEEL_PRIME.bound);
+            const __m256i DIVIDES = _mm256_cmpeq_epi32(_mm256_max_epu32(PRODUCT, BOUND), BOUND);
+            const __m256i IS_PRIME = _mm256_cmpeq_epi32(N, _mm256_set1_epi32((int)WHEEL_PRIME.prime));
+            composite = _mm256_or_si256(composite, _mm256_andnot_si256(IS_PRIME, DIVIDES));
+        } //end for
+
+        const uint64_t LANE_BITS = (uint64_t)(~_mm256_movemask_ps(_mm256_castsi256_ps(composite)) & 0xFF);
+        survivors |= LANE_BITS << i;
+    } //end for
+    return survivors & (COUNT == 64 ? ~0ULL : (1ULL << COUNT) - 1);
+} //end wheelMaskAVX2
+#endif // PRIME_KERNEL_X86
+
+typedef uint64_t (*WheelKernel)( const uint32_t *CANDIDATES, size_t COUNT );
+
+/*****************************************
+ * selectWheelKernel()
+ *
+ * @brief picks the widest kernel this CPU can run
+ *
+ * @return the AVX2 kernel if CPUID reports AVX2, otherwise the
+ *         SSE2 kernel on x86 and the scalar kernel elsewhere
+ *****************************************/
+inline WheelKernel selectWheelKernel() {
+#ifdef PRIME_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return wheelMaskAVX2;
+    return wheelMaskSSE2;
+#else
+    return wheelMaskScalar;
+#endif
+} //end selectWheelKernel
+
+/*****************************************
+ * isPrimeBatch()
+ *
+ * @brief evaluates if each of a batch of items is prime
+ *
+ * Runs the SIMD wheel over the batch first. Only the items
+ * that survive it, and items too big for a 32-bit lane, get
+ * an individual check, and survivors below WHEEL_SQUARE are
+ * prime without one.
+ *
+ * @param ITEMS   the items to be distinguished if they are prime or not
+ * @param COUNT   the number of items
+ * @param SIEVE   the table used for the individual checks
+ * @param results REFERENCE to where true / false is stored for each item
+ *****************************************/
+template<typename T>
+void isPrimeBatch( const T *ITEMS, const size_t COUNT, const PrimeSieve &SIEVE, bool *results ) {
+    static const WheelKernel KERNEL = selectWheelKernel();
+    uint32_t lanes[KERNEL_CHUNK];
+
+    for (size_t start = 0; start < COUNT; start += KERNEL_CHUNK) {
+        const size_t CHUNK = COUNT - start < KERNEL_CHUNK ? COUNT - start : KERNEL_CHUNK;
+        uint64_t wide = 0; // items that don't fit in a lane
+        for (size_t i = 0; i < CHUNK; i++) {
+            const T ITEM = ITEMS[start + i];
+            if (ITEM < 0 || (uint64_t)ITEM > UINT32_MAX) {
+                wide |= 1ULL << i;
+                lanes[i] = 0;
+            } else {
+                lanes[i] = (uint32_t)ITEM;
+            } //end else
+        } //end for
+
+        const uint64_t SURVIVORS = KERNEL(lanes, CHUNK);
+        for (size_t i = 0; i < CHUNK; i++) {
+            const T ITEM = ITEMS[start + i];
+            if (wide & (1ULL << i))
+                results[start + i] = ITEM > 0 && SIEVE.isPrime((uint64_t)ITEM);
+            else if ((SURVIVORS & (1ULL << i)) == 0)
+                results[start + i] = false;
+            else
+                results[start + i] = lanes[i] < WHEEL_SQUARE || SIEVE.isPrime(lanes[i]);
+        } //end for
+    } //end for
+} //end isPrimeBatch
+
+#endif // _PRIME_KERNEL_H_DEFINED_
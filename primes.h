@@ -0,0 +1,306 @@
+/**************************************************************************
+ *
+ *  Class Name: primes.h
+ *  Purpose:    Primality checks for the consumers in osproj4.cpp
+ *              A sieve is built once at startup so that small numbers
+ *              are checked with a single lookup, and anything larger
+ *              goes through a deterministic 64-bit Miller-Rabin test
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _PRIMES_H_DEFINED_
+#define _PRIMES_H_DEFINED_
+#include <cstdint>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+
+#define SIEVE_SEGMENT_WORDS (4096)          // 64-bit words marked at a time, 32KB so a segment stays in L1
+#define SIEVE_PARALLEL_LIMIT (1 << 22)      // ranges at least this big are built by several threads
+#define SIEVE_MAX_LIMIT (1ULL << 28)        // largest table that will be built (16MB), bigger numbers use Miller-Rabin
+
+/*****************************************
+ * isPrimeTrialDivision()
+ *
+ * @brief evaluates if the given number is prime
+ *
+ * The program cycles through potential factors of
+ * a number until it gets to the square root of the
+ * number, which can be used in the proof that the
+ * number is prime or not
+ *
+ * ** This function was referenced from the article:
+ * https://www.geeksforgeeks.org/c-program-to-check-prime-number/
+ * **
+ *
+ * @param number the integer to be distinguished if it is prime or not
+ *
+ * @return true     if number is prime
+ * @return false    if number is not prime
+ *
+ *****************************************/
+inline bool isPrimeTrialDivision( const uint64_t number ) {
+    if (number < 2) return false;
+    for (uint64_t i = 2; i <= number / i; i++) {
+        if (number % i == 0)
+            return false;
+    } //end for
+    return true;
+} //end isPrimeTrialDivision
+
+/***************************************************************
+ *
+ * @brief arithmetic modulo an odd 64-bit number without division
+ *
+ * Numbers are kept in Montgomery form (a * 2^64 mod n), where a
+ * product can be reduced back below n with two multiplications
+ * and a subtraction instead of a 128-bit division.
+ *
+ *****************************************************************/
+class Montgomery {
+
+    uint64_t modulus;                       // n, must be odd
+    uint64_t inverse;                       // n^-1 mod 2^64
+    uint64_t rSquared;                      // 2^128 mod n, used to move numbers into Montgomery form
+
+    public:
+    uint64_t one;                           // 1 in Montgomery form
+    uint64_t minusOne;                      // n - 1 in Montgomery form
+
+    explicit Montgomery( const uint64_t N ) : modulus(N), inverse(N) {
+        //each Newton step doubles the correct low bits, N * N = 1 mod 8 already gives 3
+        for (int i = 0; i < 5; i++) {
+            inverse *= 2 - N * inverse;
+        } //end for
+        const uint64_t R = (0 - N) % N; // 2^64 mod n
+        rSquared = (uint64_t)((unsigned __int128)R * R % N);
+        one = R;
+        minusOne = N - R;
+    }
+
+    // t * 2^-64 mod n, for any t < n * 2^64
+    uint64_t reduce( const unsigned __int128 T ) const {
+        const uint64_t M = (uint64_t)T * inverse;
+        const uint64_t MN_HIGH = (uint64_t)(((unsigned __int128)M * modulus) >> 64);
+        const uint64_t T_HIGH = (uint64_t)(T >> 64);
+        return T_HIGH >= MN_HIGH ? T_HIGH - MN_HIGH : T_HIGH - MN_HIGH + modulus;
+    }
+
+    uint64_t toMontgomery( const uint64_t A ) const { return reduce((unsigned __int128)(A % modulus) * rSquared); }
+    uint64_t multiply( const uint64_t A, const uint64_t B ) const { return reduce((unsigned __int128)A * B); }
+
+    // base^exponent with base already in Montgomery form
+    uint64_t power( uint64_t base, uint64_t exponent ) const {
+        uint64_t result = one;
+        while (exponent > 0) {
+            if (exponent & 1)
+                result = multiply(result, base);
+            base = multiply(base, base);
+            exponent >>= 1;
+        } //end while
+        return result;
+    }
+};
+
+/*****************************************
+ * isPrimeMillerRabin()
+ *
+ * @brief evaluates if the given number is prime
+ *
+ * Small factors are ruled out with a handful of divisions
+ * first. Survivors go through Miller-Rabin with the seven
+ * bases found by Jim Sinclair, which have no strong liars
+ * below 2^64, so the answer is exact for every uint64_t.
+ *
+ * @param number the integer to be distinguished if it is prime or not
+ *
+ * @return true     if number is prime
+ * @return false    if number is not prime
+ *
+ *****************************************/
+inline bool isPrimeMillerRabin( const uint64_t number ) {
+    static const uint32_t SMALL_PRIMES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+    static const uint64_t BASES[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+    if (number < 2) return false;
+    for (const uint32_t PRIME : SMALL_PRIMES) {
+        if (number % PRIME == 0)
+            return number == PRIME;
+    } //end for
+    if (number < 59 * 59) // no factor up to its square root
+        return true;
+
+    //number - 1 = odd * 2^twos
+    uint64_t odd = number - 1;
+    int twos = 0;
+    while ((odd & 1) == 0) {
+        odd >>= 1;
+        twos++;
+    } //end while
+
+    const Montgomery MONTGOMERY(number);
+    for (const uint64_t BASE : BASES) {
+        const uint64_t A = MONTGOMERY.toMontgomery(BASE);
+        if (A == 0) // base is a multiple of number, it says nothing
+            continue;
+
+        uint64_t x = MONTGOMERY.power(A, odd);
+        if (x == MONTGOMERY.one || x == MONTGOMERY.minusOne)
+            continue;
+
+        bool witness = true; // base proves number is composite unless a square hits -1
+        for (int i = 1; i < twos && witness; i++) {
+            x = MONTGOMERY.multiply(x, x);
+            if (x == MONTGOMERY.minusOne)
+                witness = false;
+        } //end for
+        if (witness)
+            return false;
+    } //end for
+    return true;
+} //end isPrimeMillerRabin
+
+/***************************************************************
+ *
+ * @brief a table of which numbers below a limit are prime
+ *
+ * Only odd numbers are stored, one bit each, with a set bit
+ * marking a composite. The table is built with a segmented sieve
+ * of Eratosthenes: the odd numbers are split into segments small
+ * enough to stay in cache, and large tables hand out contiguous
+ * runs of segments to one thread per CPU.
+ *
+ * Once built the table is only ever read, so any number of
+ * consumers can share it without locking. Tables are capped at
+ * SIEVE_MAX_LIMIT; numbers past the table use Miller-Rabin.
+ *
+ *****************************************************************/
+class PrimeSieve {
+
+    uint64_t limit;                         // every number below this is in the table
+    std::vector<uint64_t> composite;        // bit i is set if 2i + 1 is not prime
+    std::vector<uint32_t> basePrimes;       // odd primes up to sqrt(limit), used for marking
+
+    // a run of words one thread marks while building
+    struct Job {
+        PrimeSieve *sieve;
+        size_t firstWord;
+        size_t lastWord;
+    };
+
+    /*****************************************
+     * markWords()
+     *
+     * @brief crosses out the multiples of every base
+     *        prime in a run of words, one segment at a time
+     *
+     * @param FIRST_WORD the first word to mark
+     * @param LAST_WORD  one past the last word to mark
+     *****************************************/
+    void markWords( const size_t FIRST_WORD, const size_t LAST_WORD ) {
+        for (size_t segment = FIRST_WORD; segment < LAST_WORD; segment += SIEVE_SEGMENT_WORDS) {
+            const size_t SEGMENT_END = segment + SIEVE_SEGMENT_WORDS < LAST_WORD ? segment + SIEVE_SEGMENT_WORDS : LAST_WORD;
+            const uint64_t FIRST_BIT = (uint64_t)segment * 64;
+            const uint64_t END_BIT = (uint64_t)SEGMENT_END * 64;
+
+            for (const uint32_t PRIME : basePrimes) {
+                //the first odd multiple of PRIME in the segment, starting no lower than PRIME squared
+                const uint64_t SQUARE_BIT = ((uint64_t)PRIME * PRIME) / 2;
+                uint64_t bit;
+                if (SQUARE_BIT >= FIRST_BIT) {
+                    bit = SQUARE_BIT;
+                } else { // step forward from the square in strides of PRIME (one odd multiple each)
+                    bit = SQUARE_BIT + (FIRST_BIT - SQUARE_BIT + PRIME - 1) / PRIME * PRIME;
+                } //end else
+
+                for (; bit < END_BIT; bit += PRIME) {
+                    composite[bit / 64] |= 1ULL << (bit % 64);
+                } //end for
+            } //end for
+        } //end for
+    } //end markWords
+
+    static void* markJob( void *param ) {
+        const Job *JOB = static_cast<Job *>(param);
+        JOB->sieve->markWords(JOB->firstWord, JOB->lastWord);
+        return nullptr;
+    } //end markJob
+
+    public:
+    /*****************************************
+     * PrimeSieve Constructor
+     *
+     * @brief builds the table for every number below LIMIT
+     *        (or SIEVE_MAX_LIMIT, whichever is smaller)
+     *
+     * @param LIMIT one past the largest number the table answers for
+     *
+     ********************************************/
+    explicit PrimeSieve( const uint64_t LIMIT ) : limit(LIMIT < SIEVE_MAX_LIMIT ? LIMIT : SIEVE_MAX_LIMIT) {
+        const uint64_t BITS = (limit + 1) / 2;
+        composite.assign((size_t)((BITS + 63) / 64), 0);
+        if (composite.empty())
+            return;
+        composite[0] |= 1; // 1 is not prime
+
+        //base primes come from trial division, there are only a few thousand of them
+        for (uint32_t candidate = 3; (uint64_t)candidate * candidate < limit; candidate += 2) {
+            if (isPrimeTrialDivision(candidate))
+                basePrimes.push_back(candidate);
+        } //end for
+
+        //split the table between CPUs when it is big enough to be worth it
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (limit < SIEVE_PARALLEL_LIMIT || cpus < 2) {
+            markWords(0, composite.size());
+            return;
+        } //end if
+
+        const size_t SEGMENTS = (composite.size() + SIEVE_SEGMENT_WORDS - 1) / SIEVE_SEGMENT_WORDS;
+        const size_t THREADS = (size_t)cpus < SEGMENTS ? (size_t)cpus : SEGMENTS;
+        std::vector<pthread_t> tid(THREADS);
+        std::vector<Job> jobs(THREADS);
+        for (size_t i = 0; i < THREADS; i++) {
+            //hand out whole segments so no two threads write the same word
+            jobs[i] = {this, SEGMENTS * i / THREADS * SIEVE_SEGMENT_WORDS, SEGMENTS * (i + 1) / THREADS * SIEVE_SEGMENT_WORDS};
+            if (jobs[i].lastWord > composite.size())
+                jobs[i].lastWord = composite.size();
+            pthread_create(&tid[i], nullptr, markJob, &jobs[i]);
+        } //end for
+        for (size_t i = 0; i < THREADS; i++) {
+            pthread_join(tid[i], nullptr);
+        } //end for
+    }
+
+    /*****************************************
+     * isPrime()
+     *
+     * @brief evaluates if the given number is prime
+     *
+     * numbers inside the table are a single bit lookup,
+     * anything past it falls back to Miller-Rabin
+     *
+     * @param number the integer to be distinguished if it is prime or not
+     *
+     * @return true     if number is prime
+     * @return false    if number is not prime
+     *
+     *****************************************/
+    bool isPrime( const uint64_t number ) const {
+        if (number >= limit)
+            return isPrimeMillerRabin(number);
+        if (number % 2 == 0)
+            return number == 2;
+        const uint64_t BIT = number / 2;
+        return (composite[BIT / 64] & (1ULL << (BIT % 64))) == 0;
+    }
+};
+
+#endif // _PRIMES_H_DEFINED_
@@ -0,0 +1,304 @@
+/**************************************************************************
+ *
+ *  Class Name: priority_buffer.h
+ *  Purpose:    A buffer of several lanes, so urgent items can pass a
+ *              backlog of ordinary ones without a separate thread pool
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _PRIORITY_BUFFER_H_DEFINED_
+#define _PRIORITY_BUFFER_H_DEFINED_
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "buffer_base.h"
+
+#define PRIORITY_MAX_LANES (8)              // most lanes a priority buffer can have
+#define PRIORITY_LANE_CREDIT (8)            // default removes a waiting lane lets higher lanes take before it is served
+
+/***************************************************************
+ *
+ * @brief a buffer made of a few lanes, each its own buffer,
+ *        that consumers drain highest lane first
+ *
+ * Producers pick a lane for their items with forLane(); lane 0
+ * is the lowest and laneCount() - 1 the highest. Items of one
+ * lane come out in the order they went in, but an item in a
+ * higher lane is removed before anything in the lanes below it,
+ * however long those have been waiting.
+ *
+ * So that a steady stream of urgent items can't starve the lower
+ * lanes outright, every remove that passes over a lane holding
+ * items gives that lane a credit. Once a lane has collected the
+ * credit limit it is served next, ahead of the lanes above it,
+ * and its credits start over. A busy lower lane therefore gets at
+ * least one of every credit limit + 1 removes.
+ *
+ * A blocked producer waits for room in its own lane, and a remove
+ * only wakes producers of the lane it took from. Consumers take
+ * from every lane, so they wait on the priority buffer as a whole
+ * and any insert wakes them.
+ *
+ * @tparam T the type of item stored in the buffer
+ *
+ *****************************************************************/
+template<typename T = buffer_item>
+class PriorityBuffer : public BufferBase<T> {
+
+    /***************************************************************
+     *
+     * @brief the priority buffer as a producer of one lane sees it
+     *
+     * inserts go into the lane, removes still go highest lane first
+     *
+     *****************************************************************/
+    class LaneView : public BufferBase<T> {
+
+        PriorityBuffer *owner;              // the buffer the lane belongs to
+        size_t lane;                        // the lane this view inserts into
+
+        public:
+        LaneView( PriorityBuffer *OWNER, const size_t LANE ) : owner(OWNER), lane(LANE) {}
+
+        bool buffer_insert_item( T item ) override { return owner->insertAt(lane, &item, 1) == 1; }
+        bool buffer_remove_item( T *item ) override { return owner->removeHighest(item, 1) == 1; }
+        size_t buffer_insert_items( const T *items, size_t n ) override { return owner->insertAt(lane, items, n); }
+        size_t buffer_remove_items( T *items, size_t max ) override { return owner->removeHighest(items, max); }
+
+        bool insert_until( T item, const long long DEADLINE ) override { return owner->insertAtUntil(lane, &item, 1, DEADLINE) == 1; }
+        bool remove_until( T *item, const long long DEADLINE ) override { return owner->removeHighestUntil(item, 1, DEADLINE) == 1; }
+        size_t insert_items_until( const T *items, size_t n, const long long DEADLINE ) override {
+            return owner->insertAtUntil(lane, items, n, DEADLINE);
+        }
+        size_t remove_items_until( T *items, size_t max, const long long DEADLINE ) override {
+            return owner->removeHighestUntil(items, max, DEADLINE);
+        }
+
+        // only ever push out items of the same lane, never another lane's
+        size_t insert_evicting( T item ) override { return owner->insertLossy(lane, item, false); }
+        size_t insert_overwriting( T item ) override { return owner->insertLossy(lane, item, true); }
+
+        BufferBase<T>* forLane( const int LANE ) override { return owner->forLane(LANE); }
+
+        // DISPLAY ACCESSORS //
+        int getCapacity() const override { return owner->getCapacity(); }
+        int getSize() const override { return owner->getSize(); }
+        int getHead() const override { return owner->getHead(); }
+        int getTail() const override { return owner->getTail(); }
+        T getItem( int slot ) const override { return owner->getItem(slot); }
+    };
+
+    // one lane, on its own cache line so consumers crediting one lane don't slow removes from another
+    struct alignas(CACHE_LINE_SIZE) Lane {
+        std::unique_ptr<BufferBase<T>> ring;    // where the lane's items are stored
+        std::unique_ptr<LaneView> view;         // handed out by forLane()
+        WaitPolicy roomIn;                      // producers of the lane wait here for room in it
+        std::atomic<long long> held{0};         // items in the lane, kept here so crediting never reads the ring itself
+        std::atomic<long long> credits{0};      // removes that passed over the lane while it held items
+        std::atomic<long long> taken{0};        // items removed from the lane
+    };
+
+    // CLASS DATA MEMBERS //
+    size_t laneTotal;                           // the number of lanes
+    std::unique_ptr<Lane[]> lanes;              // lowest lane first
+    long long creditLimit;                      // credits a lane needs to be served out of turn
+    std::atomic<long long> creditServes{0};     // removes that served a lane out of turn
+
+    // takes up to max items from one lane, counting them
+    size_t takeFrom( const size_t LANE, T *items, const size_t max ) {
+        BufferBase<T> *ring = lanes[LANE].ring.get();
+        const size_t REMOVED = max == 1 ? (ring->try_remove(items) ? 1 : 0) : ring->buffer_remove_items(items, max);
+        if (REMOVED > 0) {
+            lanes[LANE].held.fetch_sub((long long)REMOVED, std::memory_order_relaxed);
+            lanes[LANE].taken.fetch_add((long long)REMOVED, std::memory_order_relaxed);
+        } //end if
+        return REMOVED;
+    }
+
+    public:
+    /*****************************************
+     * PriorityBuffer Constructor
+     *
+     * @brief builds a priority buffer out of existing buffers
+     *
+     * @param LANES        the lanes, lowest first, which the priority buffer takes ownership of
+     * @param CREDIT_LIMIT removes a waiting lane lets the lanes above it take before it is served
+     *
+     ********************************************/
+    PriorityBuffer( std::vector<std::unique_ptr<BufferBase<T>>> &&LANES, const long long CREDIT_LIMIT = PRIORITY_LANE_CREDIT )
+        : laneTotal(LANES.size()), lanes(new Lane[LANES.size()]), creditLimit(CREDIT_LIMIT) {
+        for (size_t i = 0; i < laneTotal; i++) {
+            lanes[i].ring = std::move(LANES[i]);
+            lanes[i].ring->setWaitStrategy(STRATEGY_SPIN); // nobody waits on a lane itself, so skip its notifies
+            lanes[i].view.reset(new LaneView(this, i));
+        } //end for
+    }
+
+    size_t laneCount() const { return laneTotal; }
+
+    // the view of the buffer producers of a lane should insert through
+    BufferBase<T>* forLane( const int LANE ) override {
+        const size_t CLAMPED = LANE < 0 ? 0 : ((size_t)LANE < laneTotal ? (size_t)LANE : laneTotal - 1);
+        return lanes[CLAMPED].view.get();
+    }
+
+    /*****************************************
+     * insertAt()
+     *
+     * @brief inserts a run of items into one lane without blocking
+     *
+     * @param LANE  the lane to insert into
+     * @param items the items to be inserted into the buffer
+     * @param n     the number of items
+     *
+     * @return the number of items inserted (0 if the lane was full)
+     *****************************************/
+    size_t insertAt( const size_t LANE, const T *items, const size_t n ) {
+        BufferBase<T> *ring = lanes[LANE].ring.get();
+        const size_t INSERTED = n == 1 ? (ring->try_insert(items[0]) ? 1 : 0) : ring->buffer_insert_items(items, n);
+        if (INSERTED > 0) {
+            lanes[LANE].held.fetch_add((long long)INSERTED, std::memory_order_relaxed);
+            this->notEmpty.notify(INSERTED);
+        } //end if
+        return INSERTED;
+    }
+
+    // insert_evicting() / insert_overwriting() on one lane
+    size_t insertLossy( const size_t LANE, T item, const bool OVERWRITE ) {
+        BufferBase<T> *ring = lanes[LANE].ring.get();
+        const size_t LOST = OVERWRITE ? ring->insert_overwriting(item) : ring->insert_evicting(item);
+        lanes[LANE].held.fetch_add(1 - (long long)LOST, std::memory_order_relaxed);
+        if (LOST == 0) // the buffer holds one more item than it did
+            this->notEmpty.notify(1);
+        return LOST;
+    }
+
+    /*****************************************
+     * removeHighest()
+     *
+     * @brief removes a run of items without blocking from the
+     *        highest lane holding any, unless a lower lane has
+     *        waited long enough to be served first
+     *
+     * @param items REFERENCE to where the removed items will be stored to
+     * @param max   the most items to remove
+     *
+     * @return the number of items removed (0 if every lane was empty)
+     *****************************************/
+    size_t removeHighest( T *items, const size_t max ) {
+        size_t removed = 0;
+        size_t from = 0;
+
+        //a lane that has been passed over enough goes first, lowest (most passed over) first
+        for (size_t i = 0; i + 1 < laneTotal && removed == 0; i++) {
+            long long credits = lanes[i].credits.load(std::memory_order_relaxed);
+            if (credits >= creditLimit // only the consumer that zeroes the credits serves the lane on them
+                && lanes[i].credits.compare_exchange_strong(credits, 0, std::memory_order_relaxed)) {
+                removed = takeFrom(i, items, max);
+                from = i;
+                if (removed > 0)
+                    creditServes.fetch_add(1, std::memory_order_relaxed);
+            } //end if
+        } //end for
+
+        //otherwise the highest lane with an item, crediting the lanes below it still holding items
+        for (size_t i = laneTotal; i > 0 && removed == 0; i--) {
+            removed = takeFrom(i - 1, items, max);
+            from = i - 1;
+            if (removed == 0)
+                continue;
+            for (size_t below = 0; below + 1 < i; below++) {
+                if (lanes[below].held.load(std::memory_order_relaxed) > 0)
+                    lanes[below].credits.fetch_add((long long)removed, std::memory_order_relaxed);
+            } //end for
+        } //end for
+
+        if (removed > 0)
+            lanes[from].roomIn.notify(removed);
+        return removed;
+    }
+
+    // insertAt(), waiting for room in the lane
+    size_t insertAtUntil( const size_t LANE, const T *items, const size_t n, const long long DEADLINE ) {
+        size_t inserted = insertAt(LANE, items, n);
+        if (inserted == 0 && n > 0)
+            lanes[LANE].roomIn.waitUntil(DEADLINE, [&] { return (inserted = insertAt(LANE, items, n)) > 0; },
+                                         [&] { return this->isClosed(); });
+        return inserted;
+    }
+
+    // removeHighest(), waiting for an item in any lane
+    size_t removeHighestUntil( T *items, const size_t max, const long long DEADLINE ) {
+        size_t removed = removeHighest(items, max);
+        if (removed == 0 && max > 0)
+            this->notEmpty.waitUntil(DEADLINE, [&] { return (removed = removeHighest(items, max)) > 0; },
+                                     [&] { return this->isClosed(); });
+        return removed;
+    }
+
+    // used directly (not through a lane), the priority buffer inserts into the lowest lane
+    bool buffer_insert_item( T item ) override { return insertAt(0, &item, 1) == 1; }
+    bool buffer_remove_item( T *item ) override { return removeHighest(item, 1) == 1; }
+    size_t buffer_insert_items( const T *items, size_t n ) override { return insertAt(0, items, n); }
+    size_t buffer_remove_items( T *items, size_t max ) override { return removeHighest(items, max); }
+    size_t insert_evicting( T item ) override { return insertLossy(0, item, false); }
+    size_t insert_overwriting( T item ) override { return insertLossy(0, item, true); }
+
+    bool insert_until( T item, const long long DEADLINE ) override { return insertAtUntil(0, &item, 1, DEADLINE) == 1; }
+    bool remove_until( T *item, const long long DEADLINE ) override { return removeHighestUntil(item, 1, DEADLINE) == 1; }
+    size_t insert_items_until( const T *items, size_t n, const long long DEADLINE ) override {
+        return insertAtUntil(0, items, n, DEADLINE);
+    }
+    size_t remove_items_until( T *items, size_t max, const long long DEADLINE ) override {
+        return removeHighestUntil(items, max, DEADLINE);
+    }
+
+    void close() override {
+        BufferBase<T>::close();
+        for (size_t i = 0; i < laneTotal; i++)
+            lanes[i].roomIn.wakeAll();
+    }
+
+    void setWaitStrategy( const WaitStrategy STRATEGY ) override {
+        BufferBase<T>::setWaitStrategy(STRATEGY);
+        for (size_t i = 0; i < laneTotal; i++)
+            lanes[i].roomIn.setStrategy(STRATEGY);
+    }
+
+    // DISPLAY ACCESSORS //
+    // the lanes are shown one after another, lowest first, head and tail are the lowest lane's
+    long long getTaken( const size_t LANE ) const { return lanes[LANE].taken.load(std::memory_order_relaxed); }
+    long long getCreditServes() const { return creditServes.load(std::memory_order_relaxed); }
+    long long getCreditLimit() const { return creditLimit; }
+    int getCapacity() const override {
+        int capacity = 0;
+        for (size_t i = 0; i < laneTotal; i++)
+            capacity += lanes[i].ring->getCapacity();
+        return capacity;
+    }
+    int getSize() const override {
+        int size = 0;
+        for (size_t i = 0; i < laneTotal; i++)
+            size += lanes[i].ring->getSize();
+        return size;
+    }
+    int getHead() const override { return lanes[0].ring->getHead(); }
+    int getTail() const override { return lanes[0].ring->getTail(); }
+    T getItem( int slot ) const override {
+        size_t i = 0;
+        while (slot >= lanes[i].ring->getCapacity()) {
+            slot -= lanes[i].ring->getCapacity();
+            i++;
+        } //end while
+        return lanes[i].ring->getItem(slot);
+    }
+};
+
+#endif // _PRIORITY_BUFFER_H_DEFINED_
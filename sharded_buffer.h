@@ -0,0 +1,222 @@
+/**************************************************************************
+ *
+ *  Class Name: sharded_buffer.h
+ *  Purpose:    Splits the buffer in osproj4.cpp into several independent
+ *              shards so threads stop fighting over one buffer, with
+ *              consumers stealing from other shards when theirs is empty
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _SHARDED_BUFFER_H_DEFINED_
+#define _SHARDED_BUFFER_H_DEFINED_
+#include <memory>
+#include <vector>
+#include "buffer_base.h"
+
+/***************************************************************
+ *
+ * @brief a buffer made of several smaller buffers (shards)
+ *
+ * Every thread is given a home shard by forThread(). Producers
+ * only ever insert into their home shard. Consumers take from
+ * their home shard first, and when it is empty they steal from
+ * the other shards in turn, so no item is stranded in a shard
+ * whose consumers are busy or missing.
+ *
+ * Threads sharing a home shard contend with each other, but not
+ * with anyone else, so adding shards along with threads keeps the
+ * contention per shard flat.
+ *
+ * A blocked producer waits for room in its own home shard, and a
+ * remove only wakes producers of the shard it made room in. A
+ * blocked consumer can take from any shard, so consumers wait on
+ * the sharded buffer as a whole and any insert wakes them.
+ *
+ * @tparam T the type of item stored in the buffer
+ *
+ *****************************************************************/
+template<typename T = buffer_item>
+class ShardedBuffer : public BufferBase<T> {
+
+    /***************************************************************
+     *
+     * @brief the sharded buffer as one thread sees it
+     *
+     * every call goes to the owner with the thread's home shard
+     *
+     *****************************************************************/
+    class ShardView : public BufferBase<T> {
+
+        ShardedBuffer *owner;               // the buffer the shard belongs to
+        size_t home;                        // the shard this view inserts into and removes from first
+
+        public:
+        ShardView( ShardedBuffer *OWNER, const size_t HOME ) : owner(OWNER), home(HOME) {}
+
+        bool buffer_insert_item( T item ) override { return owner->insertAt(home, &item, 1) == 1; }
+        bool buffer_remove_item( T *item ) override { return owner->removeAt(home, item, 1) == 1; }
+        size_t buffer_insert_items( const T *items, size_t n ) override { return owner->insertAt(home, items, n); }
+        size_t buffer_remove_items( T *items, size_t max ) override { return owner->removeAt(home, items, max); }
+
+        bool insert_until( T item, const long long DEADLINE ) override { return owner->insertAtUntil(home, &item, 1, DEADLINE) == 1; }
+        bool remove_until( T *item, const long long DEADLINE ) override { return owner->removeAtUntil(home, item, 1, DEADLINE) == 1; }
+        size_t insert_items_until( const T *items, size_t n, const long long DEADLINE ) override {
+            return owner->insertAtUntil(home, items, n, DEADLINE);
+        }
+        size_t remove_items_until( T *items, size_t max, const long long DEADLINE ) override {
+            return owner->removeAtUntil(home, items, max, DEADLINE);
+        }
+
+        // DISPLAY ACCESSORS //
+        int getCapacity() const override { return owner->getCapacity(); }
+        int getSize() const override { return owner->getSize(); }
+        int getHead() const override { return owner->getHead(); }
+        int getTail() const override { return owner->getTail(); }
+        T getItem( int slot ) const override { return owner->getItem(slot); }
+    };
+
+    // CLASS DATA MEMBERS //
+    std::vector<std::unique_ptr<BufferBase<T>>> shards;     // the buffers items are actually stored in
+    std::vector<std::unique_ptr<ShardView>> views;          // one view per home shard
+    std::unique_ptr<WaitPolicy[]> roomIn;                   // producers wait here for room in their home shard
+
+    public:
+    /*****************************************
+     * ShardedBuffer Constructor
+     *
+     * @brief builds a sharded buffer out of existing buffers
+     *
+     * @param SHARDS the shards, which the sharded buffer takes ownership of
+     *
+     ********************************************/
+    explicit ShardedBuffer( std::vector<std::unique_ptr<BufferBase<T>>> &&SHARDS )
+        : shards(std::move(SHARDS)), roomIn(new WaitPolicy[shards.size()]) {
+        for (size_t i = 0; i < shards.size(); i++) {
+            shards[i]->setWaitStrategy(STRATEGY_SPIN); // nobody waits on a shard itself, so skip its notifies
+            views.emplace_back(new ShardView(this, i));
+        } //end for
+    }
+
+    size_t shardCount() const { return shards.size(); }
+
+    // the view of the buffer the INDEX-th thread should use
+    BufferBase<T>* forThread( const int INDEX ) override { return views[(size_t)INDEX % shards.size()].get(); }
+
+    /*****************************************
+     * insertAt()
+     *
+     * @brief inserts a run of items into one shard without blocking
+     *
+     * @param HOME  the shard to insert into
+     * @param items the items to be inserted into the buffer
+     * @param n     the number of items
+     *
+     * @return the number of items inserted (0 if the shard was full)
+     *****************************************/
+    size_t insertAt( const size_t HOME, const T *items, const size_t n ) {
+        const size_t INSERTED = n == 1 ? (shards[HOME]->try_insert(items[0]) ? 1 : 0)
+                                       : shards[HOME]->buffer_insert_items(items, n);
+        if (INSERTED > 0)
+            this->notEmpty.notify(INSERTED);
+        return INSERTED;
+    }
+
+    /*****************************************
+     * removeAt()
+     *
+     * @brief removes a run of items without blocking, stealing
+     *        from the other shards if the home shard is empty
+     *
+     * @param HOME  the shard to take from first
+     * @param items REFERENCE to where the removed items will be stored to
+     * @param max   the most items to remove
+     *
+     * @return the number of items removed (0 if every shard was empty)
+     *****************************************/
+    size_t removeAt( const size_t HOME, T *items, const size_t max ) {
+        size_t removed = 0;
+        size_t from = HOME;
+        for (size_t i = 0; i < shards.size() && removed == 0; i++) {
+            from = (HOME + i) % shards.size();
+            BufferBase<T> *shard = shards[from].get();
+            removed = max == 1 ? (shard->try_remove(items) ? 1 : 0) : shard->buffer_remove_items(items, max);
+        } //end for
+        if (removed > 0)
+            roomIn[from].notify(removed);
+        return removed;
+    }
+
+    // insertAt(), waiting for room in the home shard
+    size_t insertAtUntil( const size_t HOME, const T *items, const size_t n, const long long DEADLINE ) {
+        size_t inserted = insertAt(HOME, items, n);
+        if (inserted == 0 && n > 0)
+            roomIn[HOME].waitUntil(DEADLINE, [&] { return (inserted = insertAt(HOME, items, n)) > 0; },
+                                   [&] { return this->isClosed(); });
+        return inserted;
+    }
+
+    // removeAt(), waiting for an item in any shard
+    size_t removeAtUntil( const size_t HOME, T *items, const size_t max, const long long DEADLINE ) {
+        size_t removed = removeAt(HOME, items, max);
+        if (removed == 0 && max > 0)
+            this->notEmpty.waitUntil(DEADLINE, [&] { return (removed = removeAt(HOME, items, max)) > 0; },
+                                     [&] { return this->isClosed(); });
+        return removed;
+    }
+
+    // used directly (not through a view), the sharded buffer behaves like its first shard's view
+    bool buffer_insert_item( T item ) override { return insertAt(0, &item, 1) == 1; }
+    bool buffer_remove_item( T *item ) override { return removeAt(0, item, 1) == 1; }
+    size_t buffer_insert_items( const T *items, size_t n ) override { return insertAt(0, items, n); }
+    size_t buffer_remove_items( T *items, size_t max ) override { return removeAt(0, items, max); }
+    bool insert_until( T item, const long long DEADLINE ) override { return insertAtUntil(0, &item, 1, DEADLINE) == 1; }
+    size_t insert_items_until( const T *items, size_t n, const long long DEADLINE ) override {
+        return insertAtUntil(0, items, n, DEADLINE);
+    }
+
+    void close() override {
+        BufferBase<T>::close();
+        for (size_t i = 0; i < shards.size(); i++)
+            roomIn[i].wakeAll();
+    }
+
+    void setWaitStrategy( const WaitStrategy STRATEGY ) override {
+        BufferBase<T>::setWaitStrategy(STRATEGY);
+        for (size_t i = 0; i < shards.size(); i++)
+            roomIn[i].setStrategy(STRATEGY);
+    }
+
+    // DISPLAY ACCESSORS //
+    // the shards are shown one after another, head and tail are the first shard's
+    int getCapacity() const override {
+        int capacity = 0;
+        for (const auto &SHARD : shards)
+            capacity += SHARD->getCapacity();
+        return capacity;
+    }
+    int getSize() const override {
+        int size = 0;
+        for (const auto &SHARD : shards)
+            size += SHARD->getSize();
+        return size;
+    }
+    int getHead() const override { return shards[0]->getHead(); }
+    int getTail() const override { return shards[0]->getTail(); }
+    T getItem( int slot ) const override {
+        size_t i = 0;
+        while (slot >= shards[i]->getCapacity()) {
+            slot -= shards[i]->getCapacity();
+            i++;
+        } //end while
+        return shards[i]->getItem(slot);
+    }
+};
+
+#endif // _SHARDED_BUFFER_H_DEFINED_
@@ -0,0 +1,316 @@
+/**************************************************************************
+ *
+ *  Class Name: shared_buffer.h
+ *  Purpose:    A circular buffer placed in a named shared memory segment,
+ *              so producers and consumers of osproj4.cpp can run in
+ *              separate processes
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _SHARED_BUFFER_H_DEFINED_
+#define _SHARED_BUFFER_H_DEFINED_
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include "buffer.h"
+
+#define SHARED_MAGIC (0x50435348U)          // "PCSH", written last once a segment is ready to attach to
+#define SHARED_ATTACH_TRIES (10000)         // how many times to look for a segment another process is still setting up
+#define SHARED_OPEN_TRIES (3)               // how many times to open a name whose last process was just removing it
+#define SHARED_REMOVED (-1)                 // attached once the last process has left and the name is being removed
+
+/***************************************************************
+ *
+ * @brief the start of a shared segment; the slots follow it
+ *
+ * Everything in here is used by several processes at once, so
+ * it only holds plain data, atomics, a process-shared robust mutex
+ * and process-shared eventcounts, never pointers.
+ *
+ *****************************************************************/
+struct alignas(CACHE_LINE_SIZE) SharedHeader {
+    std::atomic<uint32_t> ready;            // SHARED_MAGIC once the creator has finished setting up
+    uint32_t itemSize;                      // sizeof the item type, so mismatched builds / flags can't attach
+    int capacity;                           // the number of slots
+    std::atomic<int> attached;              // processes registered with the segment, 0 until it is set up and
+                                            // SHARED_REMOVED once the last one out is removing its name
+
+    int size;                               // the number of items in the buffer
+    int head;                               // location of the oldest item
+    int tail;                               // location of where the next item will go
+    pthread_mutex_t freeMutex;              // process-shared and robust, keeps track if a thread is accessing the buffer
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int> empty;    // how many empty slots producers can still reserve
+    alignas(CACHE_LINE_SIZE) std::atomic<int> full;     // how many items consumers can still reserve
+    alignas(CACHE_LINE_SIZE) EventCount notFullEvent{true};  // producers of any process park here
+    alignas(CACHE_LINE_SIZE) EventCount notEmptyEvent{true}; // consumers of any process park here
+};
+
+/***************************************************************
+ *
+ * @brief a Buffer whose slots and synchronization live in a
+ *        named POSIX shared memory segment
+ *
+ * Works like the semaphore Buffer: slots are reserved with a
+ * CAS on empty / full, and items are copied in and out under a
+ * mutex. The mutex is process-shared and parked threads sleep on
+ * process-shared futexes, so a producer process and a consumer
+ * process attached to the same name hand items to each other
+ * through memory alone.
+ *
+ * The mutex is robust, so a process that dies holding it doesn't
+ * hang every other one. Items are copied before head, tail and
+ * size are written, and removed slots are only cleared after, so
+ * the next thread to lock it finds the buffer as it was before or
+ * after the dead process's call; the slots that process had
+ * reserved are lost with it.
+ *
+ * Every process parks on the same futexes, so a SharedBuffer
+ * wakes them whatever this process's own wait strategy is.
+ *
+ * The first process to open a name creates and sets up the
+ * segment; later ones attach to it and use the capacity it was
+ * made with. Each process closes the buffer on its own, so
+ * close() only stops that process's threads. Items are copied
+ * byte for byte between processes, so they have to be trivially
+ * copyable.
+ *
+ * @tparam T the type of item stored in the buffer
+ *
+ *****************************************************************/
+template<typename T = buffer_item>
+class SharedBuffer : public BufferBase<T> {
+
+    static_assert(std::is_trivially_copyable<T>::value, "items in shared memory must be trivially copyable");
+
+    // CLASS DATA MEMBERS //
+    std::string name;                       // the shm_open name
+    SharedHeader *header = nullptr;         // the mapped segment, nullptr if it couldn't be opened
+    T *slots = nullptr;                     // the place where items are stored, right after the header
+    size_t mappedBytes = 0;
+
+    static size_t segmentBytes( const int CAPACITY ) { return sizeof(SharedHeader) + (size_t)CAPACITY * sizeof(T); }
+
+    // sets up a segment this process just created
+    bool create( const int FILE, const int CAPACITY ) {
+        mappedBytes = segmentBytes(CAPACITY);
+        if (ftruncate(FILE, (off_t)mappedBytes) != 0)
+            return false;
+        void *memory = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, FILE, 0);
+        if (memory == MAP_FAILED)
+            return false;
+        header = new (memory) SharedHeader();
+        header->itemSize = sizeof(T);
+        header->capacity = CAPACITY;
+        header->size = header->head = header->tail = 0;
+        pthread_mutexattr_t attributes;
+        pthread_mutexattr_init(&attributes);
+        pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init(&header->freeMutex, &attributes);
+        pthread_mutexattr_destroy(&attributes);
+        header->empty.store(CAPACITY, std::memory_order_relaxed);
+        header->full.store(0, std::memory_order_relaxed);
+        slots = reinterpret_cast<T *>(header + 1);
+        for (int i = 0; i < CAPACITY; i++) {
+            slots[i] = NullItem<T>::value();
+        } //end for
+        header->ready.store(SHARED_MAGIC, std::memory_order_relaxed);
+        header->attached.store(1, std::memory_order_release); // other processes can register from here on
+        return true;
+    }
+
+    // maps a segment another process created, once it is ready
+    bool attach( const int FILE ) {
+        struct stat info{};
+        for (int tries = 0; tries < SHARED_ATTACH_TRIES; tries++) { // the creator may not have sized it yet
+            if (fstat(FILE, &info) != 0)
+                return false;
+            if ((size_t)info.st_size >= sizeof(SharedHeader))
+                break;
+            usleep(100);
+        } //end for
+        if ((size_t)info.st_size < sizeof(SharedHeader))
+            return false;
+        mappedBytes = (size_t)info.st_size;
+        void *memory = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, FILE, 0);
+        if (memory == MAP_FAILED)
+            return false;
+        header = static_cast<SharedHeader *>(memory);
+
+        //register before trusting the header, so the last process out can't remove the name in between
+        bool registered = false;
+        for (int tries = 0; tries < SHARED_ATTACH_TRIES && !registered; tries++) {
+            int count = header->attached.load(std::memory_order_acquire);
+            if (count == SHARED_REMOVED) // too late, the segment is on its way out
+                break;
+            if (count > 0)
+                registered = header->attached.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel);
+            else
+                usleep(100); // the creator hasn't finished setting it up
+        } //end for
+        if (!registered) {
+            munmap(memory, mappedBytes);
+            header = nullptr;
+            return false;
+        } //end if
+        if (header->ready.load(std::memory_order_acquire) != SHARED_MAGIC || header->itemSize != sizeof(T)
+            || segmentBytes(header->capacity) > mappedBytes) { // made for another item type, back the registration out
+            detach();
+            return false;
+        } //end if
+        slots = reinterpret_cast<T *>(header + 1);
+        return true;
+    }
+
+    // unregisters this process and unmaps the segment, the last one out removes its name
+    void detach() {
+        int count = header->attached.load(std::memory_order_acquire);
+        while (!header->attached.compare_exchange_weak(count, count == 1 ? SHARED_REMOVED : count - 1, std::memory_order_acq_rel)) {
+            //another process registered or left first, try again with its count
+        } //end while
+        if (count == 1)
+            shm_unlink(name.c_str());
+        munmap(header, mappedBytes);
+        header = nullptr;
+    }
+
+    // locks the segment, taking it over from a process that died holding it
+    void lock() {
+        if (pthread_mutex_lock(&header->freeMutex) == EOWNERDEAD) // head, tail and size are still whole, see the class comment
+            pthread_mutex_consistent(&header->freeMutex);
+    }
+
+    // copies N items in after their slots have been reserved on empty
+    void putReserved( const T *items, const size_t N ) {
+        lock();
+        {
+            int tail = header->tail;
+            for (size_t i = 0; i < N; i++) {
+                slots[tail] = items[i];
+                tail = (tail + 1) % header->capacity;
+            } //end for
+            header->tail = tail;
+            header->size += (int)N;
+        }
+        pthread_mutex_unlock(&header->freeMutex);
+        header->full.fetch_add((int)N, std::memory_order_release);
+        this->notEmpty.notify(N);
+    }
+
+    // copies the N oldest items out after they have been reserved on full
+    void takeReserved( T *items, const size_t N ) {
+        lock();
+        {
+            const int HEAD = header->head;
+            for (size_t i = 0; i < N; i++) {
+                items[i] = slots[(HEAD + i) % header->capacity];
+            } //end for
+            header->head = (int)((HEAD + N) % header->capacity);
+            header->size -= (int)N;
+            for (size_t i = 0; i < N; i++) { // only cleared once head has moved past them, see the class comment
+                slots[(HEAD + i) % header->capacity] = NullItem<T>::value();
+            } //end for
+        }
+        pthread_mutex_unlock(&header->freeMutex);
+        header->empty.fetch_add((int)N, std::memory_order_release);
+        this->notFull.notify(N);
+    }
+
+    public:
+    /*****************************************
+     * SharedBuffer Constructor
+     *
+     * @brief creates the named segment, or attaches to it if another
+     *        process already has
+     *
+     * check isAttached() afterwards: the segment may not open, or
+     * may have been made for a different item type
+     *
+     * @param NAME     the shared memory name, like /osproj4
+     * @param capacity number of slots, if this process creates the segment
+     *
+     ********************************************/
+    SharedBuffer( const std::string &NAME, const size_t capacity ) : name(NAME[0] == '/' ? NAME : "/" + NAME) {
+        bool ok = false;
+        for (int tries = 0; tries < SHARED_OPEN_TRIES && !ok; tries++) { // an attach can lose to the last process leaving
+            int file = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (file >= 0) { // first one here
+                ok = create(file, (int)capacity);
+                if (!ok)
+                    shm_unlink(name.c_str());
+            } else {
+                file = shm_open(name.c_str(), O_RDWR, 0600);
+                ok = file >= 0 && attach(file);
+            } //end else
+            if (file >= 0)
+                ::close(file); // the mapping stays
+            if (!ok)
+                usleep(100);
+        } //end for
+        if (!ok)
+            return;
+        this->notFull.shareEvent(&header->notFullEvent);
+        this->notEmpty.shareEvent(&header->notEmptyEvent);
+    }
+
+    // unmaps the segment, and removes its name if no other process has it mapped
+    ~SharedBuffer() override {
+        if (header != nullptr)
+            detach();
+    }
+
+    bool isAttached() const { return header != nullptr; }
+
+    bool buffer_insert_item( T item ) override {
+        if (Buffer<T>::reserve(header->empty, 1) == 0) // the buffer is full
+            return false;
+        putReserved(&item, 1);
+        return true;
+    }
+
+    bool buffer_remove_item( T *item ) override {
+        if (Buffer<T>::reserve(header->full, 1) == 0) //the buffer is empty
+            return false;
+        takeReserved(item, 1);
+        return true;
+    }
+
+    size_t buffer_insert_items( const T *items, size_t n ) override {
+        const size_t RESERVED = Buffer<T>::reserve(header->empty, n);
+        if (RESERVED > 0)
+            putReserved(items, RESERVED);
+        return RESERVED;
+    }
+
+    size_t buffer_remove_items( T *items, size_t max ) override {
+        const size_t RESERVED = Buffer<T>::reserve(header->full, max);
+        if (RESERVED > 0)
+            takeReserved(items, RESERVED);
+        return RESERVED;
+    }
+
+    // DISPLAY ACCESSORS //
+    int getCapacity() const override { return header->capacity; }
+    int getSize() const override { return header->size; }
+    int getHead() const override { return header->head; }
+    int getTail() const override { return header->tail; }
+    T getItem( int slot ) const override { return slots[slot]; }
+};
+
+#endif // _SHARED_BUFFER_H_DEFINED_
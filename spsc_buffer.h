@@ -0,0 +1,224 @@
+/**************************************************************************
+ *
+ *  Class Name: spsc_buffer.h
+ *  Purpose:    A wait-free circular buffer that interacts with osproj4.cpp
+ *              when the simulation runs exactly one producer and one
+ *              consumer
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _SPSC_BUFFER_H_DEFINED_
+#define _SPSC_BUFFER_H_DEFINED_
+#include <atomic>
+#include <cstddef>
+#include "buffer_base.h"
+
+/***************************************************************
+ *
+ * @brief a single-producer / single-consumer wait-free circular buffer
+ *
+ * With only one thread on each side there is nothing to race for:
+ * the producer is the only writer of tail and the consumer is the
+ * only writer of head, so each side just publishes its own index
+ * with a release store and reads the other's with an acquire load.
+ *
+ * head and tail sit on separate cache lines, and each side keeps a
+ * private copy of the other's index so it only has to touch the
+ * other side's cache line when its copy says the buffer is full
+ * (or empty).
+ *
+ * Only correct with ONE producer thread and ONE consumer thread.
+ *
+ * @tparam T        the type of item stored in the buffer
+ * @tparam Capacity number of slots, or DYNAMIC_CAPACITY to pick it
+ *                  when the buffer is constructed
+ *
+ *****************************************************************/
+template<typename T = buffer_item, size_t Capacity = DYNAMIC_CAPACITY>
+class SPSCBuffer : public BufferBase<T> {
+
+    // CLASS DATA MEMBERS //
+    // producer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;     // position of where the next item will go
+    size_t cachedHead;                                      // producer's last look at head
+
+    // consumer side
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;     // position of the oldest item
+    size_t cachedTail;                                      // consumer's last look at tail
+
+    alignas(CACHE_LINE_SIZE) Ring<T, Capacity> buffer;     // the place where items are stored
+
+    public:
+    /*****************************************
+     * SPSCBuffer Constructor
+     *
+     * @brief constructor for a SPSCBuffer
+     *
+     * sets all initial pointer values to 0 and
+     * fills the buffer with a value to signify
+     * empty (-1)
+     *
+     * @param capacity  number of slots (only used with DYNAMIC_CAPACITY)
+     *
+     ********************************************/
+    explicit SPSCBuffer( size_t capacity = Capacity ? Capacity : BUFFER_SIZE ) : tail(0), cachedHead(0), head(0), cachedTail(0), buffer(capacity) {
+        for (size_t i = 0; i < buffer.capacity(); i++) { // NOLINT(*-loop-convert)
+            buffer[i] = NullItem<T>::value();
+        }
+    }
+
+
+    /*****************************************
+     * Buffer Insert Item
+     *
+     * @brief  adds an item to the buffer
+     *
+     * only rereads head when the cached copy says
+     * the buffer is full
+     *
+     * @pre         called only from the single producer thread
+     *
+     * @param item  the item to be inserted into the buffer
+     *
+     * @return      true if the item was successfully inserted into the buffer
+     * @return     false if the buffer was full
+     *
+     *****************************************/
+    bool buffer_insert_item( T item ) override {
+        const size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cachedHead == buffer.capacity()) { // looks full, check for consumer progress
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position - cachedHead == buffer.capacity()) // the buffer is full
+                return false;
+        } //end if
+
+        buffer[buffer.wrap(position)] = item;
+        tail.store(position + 1, std::memory_order_release);
+        this->notEmpty.notify(1);
+        return true;
+    }
+
+
+    /*****************************************
+    * Buffer Remove Item
+    *
+    * @brief  removes the oldest item from the buffer
+    *
+    * only rereads tail when the cached copy says
+    * the buffer is empty
+    *
+    * @pre          called only from the single consumer thread
+    *
+    * @param item   REFERENCE to location the removed item will be stored to
+    *
+    * @return       true if the item was successfully removed from the buffer
+    * @return       false if the buffer was empty
+    *
+    *****************************************/
+    bool buffer_remove_item( T *item ) override {
+        const size_t position = head.load(std::memory_order_relaxed);
+        if (position == cachedTail) { // looks empty, check for producer progress
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position == cachedTail) // the buffer is empty
+                return false;
+        } //end if
+
+        *item = buffer[buffer.wrap(position)];
+        buffer[buffer.wrap(position)] = NullItem<T>::value();
+        head.store(position + 1, std::memory_order_release);
+        this->notFull.notify(1);
+        return true;
+    }
+
+
+    /*****************************************
+     * Buffer Insert Items
+     *
+     * @brief  adds a run of items to the buffer
+     *
+     * copies as many items as fit into the buffer, wrapping
+     * around the end if needed, and publishes all of them
+     * with a single store to tail
+     *
+     * @pre         called only from the single producer thread
+     *
+     * @param items the items to be inserted into the buffer
+     * @param n     the number of items
+     *
+     * @return      the number of items inserted (0 if the buffer was full)
+     *
+     *****************************************/
+    size_t buffer_insert_items( const T *items, size_t n ) override {
+        const size_t position = tail.load(std::memory_order_relaxed);
+        size_t room = buffer.capacity() - (position - cachedHead);
+        if (room < n) { // might not fit, check for consumer progress
+            cachedHead = head.load(std::memory_order_acquire);
+            room = buffer.capacity() - (position - cachedHead);
+        } //end if
+
+        const size_t run = room < n ? room : n;
+        for (size_t i = 0; i < run; i++)
+            buffer[buffer.wrap(position + i)] = items[i];
+        tail.store(position + run, std::memory_order_release);
+        if (run > 0) // nothing changed for a waiter
+            this->notEmpty.notify(run);
+        return run;
+    }
+
+
+    /*****************************************
+     * Buffer Remove Items
+     *
+     * @brief  removes a run of the oldest items from the buffer
+     *
+     * copies up to max items out of the buffer, wrapping around
+     * the end if needed, and frees all of their slots with a
+     * single store to head
+     *
+     * @pre         called only from the single consumer thread
+     *
+     * @param items REFERENCE to where the removed items will be stored to
+     * @param max   the most items to remove
+     *
+     * @return      the number of items removed (0 if the buffer was empty)
+     *
+     *****************************************/
+    size_t buffer_remove_items( T *items, size_t max ) override {
+        const size_t position = head.load(std::memory_order_relaxed);
+        size_t available = cachedTail - position;
+        if (available < max) { // might be more, check for producer progress
+            cachedTail = tail.load(std::memory_order_acquire);
+            available = cachedTail - position;
+        } //end if
+
+        const size_t run = available < max ? available : max;
+        for (size_t i = 0; i < run; i++) {
+            items[i] = buffer[buffer.wrap(position + i)];
+            buffer[buffer.wrap(position + i)] = NullItem<T>::value();
+        } //end for
+        head.store(position + run, std::memory_order_release);
+        if (run > 0) // nothing changed for a waiter
+            this->notFull.notify(run);
+        return run;
+    }
+
+    // DISPLAY ACCESSORS //
+    int getCapacity() const override { return (int)buffer.capacity(); }
+    int getSize() const override {
+        const size_t first = head.load(std::memory_order_relaxed);
+        const size_t last = tail.load(std::memory_order_relaxed);
+        return last > first ? (int)(last - first) : 0;
+    }
+    int getHead() const override { return (int)buffer.wrap(head.load(std::memory_order_relaxed)); }
+    int getTail() const override { return (int)buffer.wrap(tail.load(std::memory_order_relaxed)); }
+    T getItem( int slot ) const override { return buffer[slot]; }
+};
+
+#endif // _SPSC_BUFFER_H_DEFINED_
@@ -0,0 +1,72 @@
+/**************************************************************************
+ *
+ *  Class Name: stamped_item.h
+ *  Purpose:    An envelope that carries the time an item was inserted
+ *              through the buffer along with the item, and helpers that
+ *              let osproj4.cpp treat plain and stamped items the same way
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _STAMPED_ITEM_H_DEFINED_
+#define _STAMPED_ITEM_H_DEFINED_
+#include <cstddef>
+#include <vector>
+#include "buffer_base.h"
+#include "latency_histogram.h"
+#include "thread_stats.h"
+
+// a buffer_item plus when it went into the buffer
+struct StampedItem {
+    buffer_item value;
+    long long enqueued;                     // nowNanoseconds() when the producer inserted it
+};
+
+template<>
+struct NullItem<StampedItem> {
+    static StampedItem value() { return {NullItem<buffer_item>::value(), 0}; }
+};
+
+/**** PLAIN / STAMPED ITEM HELPERS ****/
+// the number an item carries
+inline buffer_item itemValue( const buffer_item ITEM ) { return ITEM; }
+inline buffer_item itemValue( const StampedItem &ITEM ) { return ITEM.value; }
+
+// sets the number an item carries
+inline void setItemValue( buffer_item &item, const buffer_item VALUE ) { item = VALUE; }
+inline void setItemValue( StampedItem &item, const buffer_item VALUE ) { item.value = VALUE; }
+
+// marks a run of items as inserted now (plain items have nowhere to put it)
+inline void stampItems( buffer_item *, size_t ) {}
+inline void stampItems( StampedItem *items, const size_t COUNT ) {
+    const long long NOW = nowNanoseconds();
+    for (size_t i = 0; i < COUNT; i++) {
+        items[i].enqueued = NOW;
+    } //end for
+}
+
+// the numbers a run of items carry, copied into scratch only if they have to be
+inline const buffer_item* itemValues( const buffer_item *ITEMS, size_t, std::vector<buffer_item> & ) { return ITEMS; }
+inline const buffer_item* itemValues( const StampedItem *ITEMS, const size_t COUNT, std::vector<buffer_item> &scratch ) {
+    for (size_t i = 0; i < COUNT; i++) {
+        scratch[i] = ITEMS[i].value;
+    } //end for
+    return scratch.data();
+}
+
+// records how long a run of just removed items sat in the buffer
+inline void recordLatencies( const buffer_item *, size_t, LatencyHistogram * ) {}
+inline void recordLatencies( const StampedItem *ITEMS, const size_t COUNT, LatencyHistogram *histogram ) {
+    const long long NOW = nowNanoseconds();
+    for (size_t i = 0; i < COUNT; i++) {
+        histogram->record((uint64_t)(NOW - ITEMS[i].enqueued));
+    } //end for
+}
+
+#endif // _STAMPED_ITEM_H_DEFINED_
@@ -0,0 +1,57 @@
+/**************************************************************************
+ *
+ *  Class Name: start_gate.h
+ *  Purpose:    Holds every producer and consumer of osproj4.cpp at the
+ *              starting line until all of them have been created
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _START_GATE_H_DEFINED_
+#define _START_GATE_H_DEFINED_
+#include <atomic>
+#include "eventcount.h"
+
+/***************************************************************
+ *
+ * @brief a one-shot barrier threads wait at until it is opened
+ *
+ * Unlike a pthread barrier, the number of threads doesn't have
+ * to be known up front, so main() can open the gate even if the
+ * system refused to create some of the threads. Waiting threads
+ * sleep on a futex, so hundreds of them cost nothing while the
+ * rest are being created.
+ *
+ *****************************************************************/
+class StartGate {
+
+    std::atomic<bool> opened{false};
+    EventCount event;                       // where threads sleep until open()
+
+    public:
+    // blocks the calling thread until open() has been called
+    void wait() {
+        while (!opened.load(std::memory_order_acquire)) {
+            const uint32_t KEY = event.prepareWait();
+            if (opened.load(std::memory_order_acquire)) {
+                event.cancelWait();
+                return;
+            } //end if
+            event.wait(KEY, LLONG_MAX);
+        } //end while
+    }
+
+    // lets every waiting thread, and any that arrives later, through
+    void open() {
+        opened.store(true, std::memory_order_release);
+        event.notifyAll();
+    }
+};
+
+#endif // _START_GATE_H_DEFINED_
@@ -0,0 +1,121 @@
+/**************************************************************************
+ *
+ *  Class Name: think_time.h
+ *  Purpose:    How long producers and consumers in osproj4.cpp pause
+ *              between actions, with nanosecond resolution
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _THINK_TIME_H_DEFINED_
+#define _THINK_TIME_H_DEFINED_
+#include <cerrno>
+#include <cmath>
+#include <ctime>
+#include <string>
+#include "xoshiro.h"
+
+#define NANOSECONDS_PER_SECOND (1000000000LL)
+
+enum ThinkDistribution {
+    THINK_NONE,                             // never pause, loop flat out
+    THINK_CONSTANT,                         // always pause for the scale
+    THINK_UNIFORM,                          // pause anywhere from 0 up to the scale
+    THINK_EXPONENTIAL                       // pause a random time averaging the scale
+};
+
+/***************************************************************
+ *
+ * @brief a model of how long a thread "thinks" between actions
+ *
+ * Each thread draws its pauses from its own random number
+ * generator, so one ThinkTime can be shared by every thread.
+ * Pauses are slept with clock_nanosleep, so they are not rounded
+ * to whole seconds.
+ *
+ *****************************************************************/
+class ThinkTime {
+
+    ThinkDistribution distribution;
+    long long scale;                        // nanoseconds: the constant, the uniform max, or the exponential mean
+
+    public:
+    ThinkTime( const ThinkDistribution DISTRIBUTION, const long long SCALE )
+        : distribution(DISTRIBUTION), scale(SCALE) {}
+
+    /*****************************************
+     * parseDistribution()
+     *
+     * @brief reads a distribution name from the command line
+     *
+     * @param NAME   none, constant, uniform or exponential
+     * @param result REFERENCE to where the distribution is stored
+     *
+     * @return true if NAME is a known distribution
+     *****************************************/
+    static bool parseDistribution( const std::string &NAME, ThinkDistribution &result ) {
+        if (NAME == "none") result = THINK_NONE;
+        else if (NAME == "constant") result = THINK_CONSTANT;
+        else if (NAME == "uniform") result = THINK_UNIFORM;
+        else if (NAME == "exponential") result = THINK_EXPONENTIAL;
+        else return false;
+        return true;
+    }
+
+    bool isNone() const { return distribution == THINK_NONE || scale <= 0; }
+
+    // draws the length of the next pause in nanoseconds
+    long long next( Xoshiro256 &random ) const {
+        switch (distribution) {
+            case THINK_CONSTANT:
+                return scale;
+            case THINK_UNIFORM:
+                return (long long)random.below((uint64_t)scale);
+            case THINK_EXPONENTIAL: { // inverse of the CDF, u in (0, 1]
+                const double U = (double)((random.next() >> 11) + 1) * 0x1.0p-53;
+                return (long long)(-std::log(U) * (double)scale);
+            }
+            default:
+                return 0;
+        } //end switch
+    }
+
+    /*****************************************
+     * wait()
+     *
+     * @brief pauses the calling thread for its next think time
+     *
+     * @param random **REFERENCE** the calling thread's random number generator
+     *****************************************/
+    void wait( Xoshiro256 &random ) const {
+        if (isNone())
+            return;
+        const long long PAUSE = next(random);
+        if (PAUSE <= 0)
+            return;
+        timespec request{};
+        request.tv_sec = PAUSE / NANOSECONDS_PER_SECOND;
+        request.tv_nsec = PAUSE % NANOSECONDS_PER_SECOND;
+        while (clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR) {
+            //interrupted by a signal, sleep whatever is left
+        } //end while
+    }
+
+    // a short description for the final statistics
+    std::string describe() const {
+        switch (isNone() ? THINK_NONE : distribution) {
+            case THINK_CONSTANT: return "constant " + std::to_string(scale) + " ns";
+            case THINK_UNIFORM: return "uniform 0 - " + std::to_string(scale) + " ns";
+            case THINK_EXPONENTIAL: return "exponential, mean " + std::to_string(scale) + " ns";
+            default: return "none";
+        } //end switch
+    }
+};
+
+#endif // _THINK_TIME_H_DEFINED_
@@ -0,0 +1,108 @@
+/**************************************************************************
+ *
+ *  Class Name: thread_stats.h
+ *  Purpose:    Per-thread counters for osproj4.cpp that threads can bump
+ *              on every action without sharing a cache line
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _THREAD_STATS_H_DEFINED_
+#define _THREAD_STATS_H_DEFINED_
+#include <atomic>
+#include "buffer_base.h"
+
+/***************************************************************
+ *
+ * @brief a counter with exactly one writer
+ *
+ * Only the thread that owns the counter ever adds to it, so an
+ * add is a plain load and store instead of a locked read-modify-
+ * write. The value is still atomic so that another thread can
+ * read a running total at any time.
+ *
+ *****************************************************************/
+class StatCounter {
+
+    std::atomic<long long> value{0};
+
+    public:
+    // only called by the owning thread
+    void add( long long amount ) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    long long get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/***************************************************************
+ *
+ * @brief everything one producer or consumer keeps count of
+ *
+ * Each thread gets its own block, padded out to a full cache line
+ * so that threads bumping their counters never invalidate each
+ * other's caches.
+ *
+ *****************************************************************/
+struct alignas(CACHE_LINE_SIZE) ThreadStats {
+    StatCounter actions;                    // items the thread produced or consumed
+    StatCounter bufferFull;                 // times the thread found the buffer full
+    StatCounter bufferEmpty;                // times the thread found the buffer empty
+    StatCounter primes;                     // items the thread consumed that were prime
+    StatCounter waitNanoseconds;            // time the thread spent sleeping or waiting
+    StatCounter dropped;                    // items a producer threw away because the buffer was full
+    StatCounter evicted;                    // oldest items a producer removed to make room
+    StatCounter overwritten;                // oldest items a producer wrote over
+};
+
+/***************************************************************
+ *
+ * @brief the sum of a group of ThreadStats at one moment
+ *
+ *****************************************************************/
+struct StatTotals {
+    long long actions = 0;
+    long long bufferFull = 0;
+    long long bufferEmpty = 0;
+    long long primes = 0;
+    long long waitNanoseconds = 0;
+    long long dropped = 0;
+    long long evicted = 0;
+    long long overwritten = 0;
+};
+
+/*****************************************
+ * sumStats()
+ *
+ * @brief adds up the counters of a group of threads
+ *
+ * safe to call while the threads are still running,
+ * in which case the totals are a recent snapshot
+ *
+ * @param STATS the first block to add
+ * @param COUNT the number of blocks to add
+ *
+ * @return the totals of every counter
+ *****************************************/
+inline StatTotals sumStats( const ThreadStats *STATS, const int COUNT ) {
+    StatTotals totals;
+    for (int i = 0; i < COUNT; i++) {
+        totals.actions += STATS[i].actions.get();
+        totals.bufferFull += STATS[i].bufferFull.get();
+        totals.bufferEmpty += STATS[i].bufferEmpty.get();
+        totals.primes += STATS[i].primes.get();
+        totals.waitNanoseconds += STATS[i].waitNanoseconds.get();
+        totals.dropped += STATS[i].dropped.get();
+        totals.evicted += STATS[i].evicted.get();
+        totals.overwritten += STATS[i].overwritten.get();
+    } //end for
+    return totals;
+} //end sumStats
+
+#endif // _THREAD_STATS_H_DEFINED_
@@ -0,0 +1,210 @@
+/**************************************************************************
+ *
+ *  Class Name: trace.h
+ *  Purpose:    Records every insert and remove of a run of osproj4.cpp to a
+ *              compact binary file, and reads the file back so the same
+ *              producer traffic can be replayed into any buffer backend
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _TRACE_H_DEFINED_
+#define _TRACE_H_DEFINED_
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <pthread.h>
+#include <string>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+#include "buffer_base.h"
+
+#define TRACE_MAGIC "PCTRACE"               // first bytes of every trace file
+#define TRACE_VERSION (3)                   // 2 widened slot to 32 bits, 3 packed op in with thread
+#define TRACE_THREAD_BITS (24)              // low bits of TraceRecord::threadOp that hold the REF_ID
+#define TRACE_CHUNK (8192)                  // records a thread collects before writing them out
+
+enum TraceOp : uint8_t {
+    TRACE_INSERT,                           // a producer put value in the buffer
+    TRACE_REMOVE                            // a consumer took value out of the buffer
+};
+
+// the start of a trace file
+struct TraceHeader {
+    char magic[8];                          // TRACE_MAGIC
+    uint32_t version;                       // TRACE_VERSION
+    uint32_t recordSize;                    // sizeof(TraceRecord), to catch files from other builds
+};
+
+// one insert or remove
+struct TraceRecord {
+    int64_t timestamp;                      // nanoseconds since start() (when the run's start gate opened)
+    int64_t value;                          // the item moved
+    int32_t slot;                           // where the buffer's tail (insert) or head (remove) was right after
+    uint32_t threadOp;                      // REF_ID of the thread that moved it, with the TraceOp in the top 8 bits
+
+    int thread() const { return (int)(threadOp & ((1u << TRACE_THREAD_BITS) - 1)); }
+    TraceOp op() const { return (TraceOp)(threadOp >> TRACE_THREAD_BITS); }
+};
+
+/***************************************************************
+ *
+ * @brief writes a trace of a run as it happens
+ *
+ * Each thread appends records to its own chunk in memory, with no
+ * locking. A full chunk is written with one call while holding the
+ * file lock, and finish() writes every thread's last chunk with a
+ * single writev.
+ *
+ *****************************************************************/
+class TraceRecorder {
+
+    std::vector<std::vector<TraceRecord>> chunks;           // one per thread, indexed by REF_ID
+    int file;                                               // the trace file
+    long long startTime;                                    // timestamps are relative to this, see start()
+    pthread_mutex_t fileMutex = PTHREAD_MUTEX_INITIALIZER;  // keeps chunks from interleaving in the file
+
+    // writes a list of chunks at once, in as few writev calls as IOV_MAX allows
+    void writeChunks( std::vector<iovec> &pieces ) {
+        pthread_mutex_lock(&fileMutex);
+        for (size_t first = 0; first < pieces.size(); first += IOV_MAX) {
+            const int COUNT = (int)std::min(pieces.size() - first, (size_t)IOV_MAX);
+            size_t remaining = 0;
+            for (int i = 0; i < COUNT; i++)
+                remaining += pieces[first + i].iov_len;
+
+            iovec *next = &pieces[first];
+            int left = COUNT;
+            while (remaining > 0) {
+                const ssize_t WRITTEN = writev(file, next, left);
+                if (WRITTEN <= 0)
+                    break; // out of disk, nothing more can be saved
+                remaining -= (size_t)WRITTEN;
+                for (size_t done = (size_t)WRITTEN; done > 0 && left > 0; ) { // skip what was written
+                    const size_t STEP = std::min(done, next->iov_len);
+                    next->iov_base = static_cast<char *>(next->iov_base) + STEP;
+                    next->iov_len -= STEP;
+                    done -= STEP;
+                    if (next->iov_len == 0) {
+                        next++;
+                        left--;
+                    } //end if
+                } //end for
+            } //end while
+        } //end for
+        pthread_mutex_unlock(&fileMutex);
+    }
+
+    public:
+    /*****************************************
+     * TraceRecorder Constructor
+     *
+     * @param PATH    the file to write the trace to (replaced if it exists)
+     * @param THREADS how many threads will record (REF_IDs 0 up to this)
+     *
+     ********************************************/
+    TraceRecorder( const std::string &PATH, const int THREADS )
+        : chunks(THREADS), file(open(PATH.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), startTime(nowNanoseconds()) {
+        for (std::vector<TraceRecord> &chunk : chunks)
+            chunk.reserve(TRACE_CHUNK);
+        if (file < 0)
+            return;
+        TraceHeader header{};
+        memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+        header.version = TRACE_VERSION;
+        header.recordSize = sizeof(TraceRecord);
+        std::vector<iovec> pieces = {{&header, sizeof(header)}};
+        writeChunks(pieces);
+    }
+
+    ~TraceRecorder() {
+        if (file >= 0)
+            close(file);
+    }
+
+    bool isOpen() const { return file >= 0; }
+
+    // sets the time timestamps count from, called before any thread records; replays count from the same point
+    void start( const long long START_TIME ) { startTime = START_TIME; }
+
+    // records one insert / remove, only ever called by the thread THREAD
+    void record( const int THREAD, const TraceOp OP, const buffer_item VALUE, const int SLOT ) {
+        std::vector<TraceRecord> &chunk = chunks[THREAD];
+        chunk.push_back({nowNanoseconds() - startTime, (int64_t)VALUE, (int32_t)SLOT,
+                         (uint32_t)THREAD | (uint32_t)OP << TRACE_THREAD_BITS});
+        if (chunk.size() == TRACE_CHUNK) {
+            std::vector<iovec> pieces = {{chunk.data(), chunk.size() * sizeof(TraceRecord)}};
+            writeChunks(pieces);
+            chunk.clear();
+        } //end if
+    }
+
+    // writes every thread's last records, once every recording thread has stopped
+    void finish() {
+        std::vector<iovec> pieces;
+        for (std::vector<TraceRecord> &chunk : chunks) {
+            if (!chunk.empty())
+                pieces.push_back({chunk.data(), chunk.size() * sizeof(TraceRecord)});
+        } //end for
+        writeChunks(pieces);
+        for (std::vector<TraceRecord> &chunk : chunks)
+            chunk.clear();
+    }
+};
+
+/*****************************************
+ * loadProducerSchedules()
+ *
+ * @brief reads the inserts out of a trace file
+ *
+ * @param PATH      the trace file
+ * @param schedules REFERENCE to where each recorded producer's
+ *                  inserts are stored, in time order
+ *
+ * @return true if the file is a trace this build can read
+ *****************************************/
+inline bool loadProducerSchedules( const std::string &PATH, std::vector<std::vector<TraceRecord>> &schedules ) {
+    FILE *file = fopen(PATH.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+    TraceHeader header{};
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0
+        || header.version != TRACE_VERSION || header.recordSize != sizeof(TraceRecord)) {
+        fclose(file);
+        return false;
+    } //end if
+
+    std::map<int32_t, std::vector<TraceRecord>> byThread;
+    TraceRecord records[TRACE_CHUNK];
+    size_t count;
+    while ((count = fread(records, sizeof(TraceRecord), TRACE_CHUNK, file)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            if (records[i].op() == TRACE_INSERT)
+                byThread[records[i].thread()].push_back(records[i]);
+        } //end for
+    } //end while
+    fclose(file);
+
+    schedules.clear();
+    for (auto &entry : byThread) {
+        std::sort(entry.second.begin(), entry.second.end(), []( const TraceRecord &A, const TraceRecord &B ) {
+            return A.timestamp < B.timestamp;
+        });
+        schedules.push_back(std::move(entry.second));
+    } //end for
+    return true;
+} //end loadProducerSchedules
+
+#endif // _TRACE_H_DEFINED_
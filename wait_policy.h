@@ -0,0 +1,217 @@
+/**************************************************************************
+ *
+ *  Class Name: wait_policy.h
+ *  Purpose:    How a thread blocked on a buffer waits for room or an item:
+ *              spinning, yielding, parking on a futex, or a mix of the
+ *              three that adapts to how long waits have been lately
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _WAIT_POLICY_H_DEFINED_
+#define _WAIT_POLICY_H_DEFINED_
+#include <atomic>
+#include <climits>
+#include <ctime>
+#include <sched.h>
+#include <string>
+#include "eventcount.h"
+
+#define NO_DEADLINE (LLONG_MAX)             // deadline for a wait that only ends when it succeeds or the buffer is closed
+
+#define SPIN_MIN (16)                       // fewest pauses an adaptive waiter spins for
+#define SPIN_MAX (8192)                     // most pauses an adaptive waiter spins for
+#define SPIN_START (256)                    // pauses an adaptive waiter starts out spinning for
+#define SPIN_CHECK_EVERY (64)               // pauses between checks of the clock while spinning
+#define YIELDS_BEFORE_PARK (4)              // times an adaptive waiter yields the CPU before it parks
+
+/*****************************************
+ * nowNanoseconds()
+ *
+ * @brief reads the monotonic clock
+ *
+ * deadlines given to the buffers are in this clock
+ *
+ * @return nanoseconds since an arbitrary fixed point
+ *****************************************/
+inline long long nowNanoseconds() {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+} //end nowNanoseconds
+
+enum WaitStrategy {
+    STRATEGY_SPIN,                          // busy-spin with pause until done
+    STRATEGY_YIELD,                         // spin a little, then sched_yield until done
+    STRATEGY_PARK,                          // sleep on a futex right away
+    STRATEGY_ADAPTIVE                       // spin, yield a few times, then sleep on a futex
+};
+
+// tells the CPU this is a spin loop (saves power, and a sibling hyperthread gets the core)
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/***************************************************************
+ *
+ * @brief one condition of a buffer (not full, or not empty) and
+ *        how threads wait on it
+ *
+ * A buffer has two of these. Threads that made the condition true
+ * call notify(); threads waiting for it call waitUntil().
+ *
+ * The adaptive strategy keeps a spin limit shared by everyone
+ * waiting on the condition. When spinning pays off the limit moves
+ * toward twice the spins it took, and when a waiter spins out and
+ * has to park the limit shrinks, so short handoffs stay in user
+ * space and long waits quickly stop burning CPU.
+ *
+ * Only parking strategies need notify() to do anything, so
+ * spin and yield leave the insert / remove path untouched.
+ *
+ *****************************************************************/
+class WaitPolicy {
+
+    WaitStrategy strategy = STRATEGY_ADAPTIVE;
+    std::atomic<int> spinLimit{SPIN_START}; // pauses to spin for before yielding (adaptive only)
+    EventCount ownEvent{false, true};       // where parked waiters sleep, notified on every insert / remove
+    EventCount *event = &ownEvent;          // or an event shared with other processes, see shareEvent()
+
+    // moves the spin limit after a wait, only ever off by a racing update
+    void adapt( const long long SPINS, const bool SUCCEEDED ) {
+        const int LIMIT = spinLimit.load(std::memory_order_relaxed);
+        int next;
+        if (SUCCEEDED) {
+            const long long TARGET = SPINS * 2 < SPIN_MIN ? SPIN_MIN : (SPINS * 2 > SPIN_MAX ? SPIN_MAX : SPINS * 2);
+            next = LIMIT + (int)((TARGET - LIMIT) / 8);
+        } else {
+            next = LIMIT - LIMIT / 8;
+        } //end else
+        spinLimit.store(next < SPIN_MIN ? SPIN_MIN : next, std::memory_order_relaxed);
+    }
+
+    public:
+    /*****************************************
+     * parseStrategy()
+     *
+     * @brief reads a wait strategy from the command line
+     *
+     * @param NAME   spin, yield, park or adaptive
+     * @param result REFERENCE to where the strategy is stored
+     *
+     * @return true if NAME is a known strategy
+     *****************************************/
+    static bool parseStrategy( const std::string &NAME, WaitStrategy &result ) {
+        if (NAME == "spin") result = STRATEGY_SPIN;
+        else if (NAME == "yield") result = STRATEGY_YIELD;
+        else if (NAME == "park") result = STRATEGY_PARK;
+        else if (NAME == "adaptive") result = STRATEGY_ADAPTIVE;
+        else return false;
+        return true;
+    }
+
+    /*****************************************
+     * shareEvent()
+     *
+     * @brief parks waiters on an event outside this object
+     *
+     * lets a buffer in shared memory park the threads of every
+     * process attached to it on one process-shared event; set
+     * before any thread starts using the buffer. Another process
+     * may park on it whatever strategy this one uses, so notify()
+     * always wakes a shared event.
+     *
+     * @param shared the event to use, it must outlive this policy
+     *****************************************/
+    void shareEvent( EventCount *shared ) { event = shared; }
+
+    // set before any thread starts using the buffer
+    void setStrategy( const WaitStrategy STRATEGY ) { strategy = STRATEGY; }
+    bool parks() const { return strategy == STRATEGY_PARK || strategy == STRATEGY_ADAPTIVE; }
+
+    // called after making the condition true for N waiters
+    void notify( const size_t N ) {
+        if (!parks() && event == &ownEvent) // nobody here parks, and no other process can
+            return;
+        if (N == 1)
+            event->notifyOne();
+        else
+            event->notifyAll();
+    }
+
+    // wakes every parked waiter so it can see the buffer was closed
+    void wakeAll() { event->notifyAll(); }
+
+    /*****************************************
+     * waitUntil()
+     *
+     * @brief retries an attempt until it succeeds, waiting between
+     *        tries the way the strategy says to
+     *
+     * @param DEADLINE nowNanoseconds() time to give up at
+     * @param attempt  one non-blocking try, returns true when it succeeded
+     * @param stopped  returns true once the buffer is closed
+     *
+     * @return true if an attempt succeeded
+     *****************************************/
+    template<typename Attempt, typename Stopped>
+    bool waitUntil( const long long DEADLINE, Attempt attempt, Stopped stopped ) {
+        //SPIN
+        const long long SPIN_LIMIT = strategy == STRATEGY_SPIN ? LLONG_MAX
+                                   : strategy == STRATEGY_PARK ? 0
+                                   : strategy == STRATEGY_YIELD ? SPIN_START
+                                   : spinLimit.load(std::memory_order_relaxed);
+        for (long long spins = 1; spins <= SPIN_LIMIT; spins++) {
+            cpuRelax();
+            if (attempt()) {
+                if (strategy == STRATEGY_ADAPTIVE)
+                    adapt(spins, true);
+                return true;
+            } //end if
+            if (spins % SPIN_CHECK_EVERY == 0 && (stopped() || nowNanoseconds() >= DEADLINE))
+                return false;
+        } //end for
+        if (strategy == STRATEGY_ADAPTIVE)
+            adapt(SPIN_LIMIT, false);
+
+        //YIELD
+        const int YIELD_LIMIT = strategy == STRATEGY_YIELD ? INT_MAX
+                              : strategy == STRATEGY_ADAPTIVE ? YIELDS_BEFORE_PARK : 0;
+        for (int yields = 0; yields < YIELD_LIMIT; yields++) {
+            if (stopped() || nowNanoseconds() >= DEADLINE)
+                return false;
+            sched_yield();
+            if (attempt())
+                return true;
+        } //end for
+
+        //PARK
+        while (!stopped() && nowNanoseconds() < DEADLINE) {
+            const uint32_t KEY = event->prepareWait();
+            if (attempt()) { // recheck now that a notify will see this thread waiting
+                event->cancelWait();
+                return true;
+            } //end if
+            if (stopped()) {
+                event->cancelWait();
+                return false;
+            } //end if
+            event->wait(KEY, DEADLINE);
+            if (attempt())
+                return true;
+        } //end while
+        return false;
+    }
+};
+
+#endif // _WAIT_POLICY_H_DEFINED_
@@ -0,0 +1,109 @@
+/**************************************************************************
+ *
+ *  Class Name: xoshiro.h
+ *  Purpose:    A small, fast random number generator that every thread in
+ *              osproj4.cpp owns a copy of, so no thread ever shares
+ *              random state or waits on rand()'s internal lock
+ *  Author:     Xander Palermo <ajp2s@missouristate.edu>
+ *  Date:       17 October 2026
+ *
+ *  Programming Project #3:     Process Synchronization Using Pthreads
+ *  Lecture:                    CSC360 - Operating Systems
+ *  Instructor:                 Dr. Siming Liu
+ *
+ *************************************************************************/
+
+
+#ifndef _XOSHIRO_H_DEFINED_
+#define _XOSHIRO_H_DEFINED_
+#include <cstdint>
+
+/***************************************************************
+ *
+ * @brief the xoshiro256** generator by Blackman and Vigna
+ *
+ * The 256-bit state is filled from a single 64-bit seed with
+ * splitmix64, as its authors recommend. Threads seeded with the
+ * same seed are given separate streams with jump(), which skips
+ * 2^128 numbers ahead, so no two threads ever see overlapping
+ * sequences and a run with a fixed seed is repeatable.
+ *
+ * Not thread safe: each thread needs its own generator.
+ *
+ *****************************************************************/
+class Xoshiro256 {
+
+    uint64_t state[4];
+
+    static uint64_t rotateLeft( const uint64_t X, const int K ) { return (X << K) | (X >> (64 - K)); }
+
+    public:
+    /*****************************************
+     * Xoshiro256 Constructor
+     *
+     * @brief seeds the generator and moves it to its stream
+     *
+     * @param seed   the seed shared by every thread of a run
+     * @param stream which of the non-overlapping streams to use
+     *
+     ********************************************/
+    explicit Xoshiro256( uint64_t seed, const unsigned stream = 0 ) {
+        for (uint64_t &word : state) { // splitmix64
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        } //end for
+        for (unsigned i = 0; i < stream; i++) {
+            jump();
+        } //end for
+    }
+
+    // the next 64 random bits
+    uint64_t next() {
+        const uint64_t RESULT = rotateLeft(state[1] * 5, 7) * 9;
+        const uint64_t T = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= T;
+        state[3] = rotateLeft(state[3], 45);
+        return RESULT;
+    }
+
+    // a random number from 0 up to bound, scaled by multiplication instead of %
+    uint64_t below( const uint64_t BOUND ) {
+        return (uint64_t)(((unsigned __int128)next() * BOUND) >> 64);
+    }
+
+    /*****************************************
+     * jump()
+     *
+     * @brief advances the generator 2^128 numbers
+     *
+     * equivalent to 2^128 calls to next(), used to
+     * hand out non-overlapping streams
+     *****************************************/
+    void jump() {
+        static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                        0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+        uint64_t jumped[4] = {0, 0, 0, 0};
+        for (const uint64_t WORD : JUMP) {
+            for (int bit = 0; bit < 64; bit++) {
+                if (WORD & (1ULL << bit)) {
+                    for (int i = 0; i < 4; i++) {
+                        jumped[i] ^= state[i];
+                    } //end for
+                } //end if
+                next();
+            } //end for
+        } //end for
+        for (int i = 0; i < 4; i++) {
+            state[i] = jumped[i];
+        } //end for
+    }
+};
+
+#endif // _XOSHIRO_H_DEFINED_